@@ -0,0 +1,119 @@
+/* 
+ * Can receive implementation - ECAN Mode 2 setup and FIFO reading
+ * 
+ * File:   canReceive.c
+ * Author: pojd
+ *
+ * Created on November 26, 2018, 8:17 PM
+ */
+
+#include "canReceive.h"
+
+/** 
+ * All receive buffers in the order as numbered by the FIFO read pointer (CANCON FP bits): RXB0, RXB1, B0 .. B5 
+ */
+volatile byte* receiveBuffers[8] = { &RXB0CON, &RXB1CON, &B0CON, &B1CON, &B2CON, &B3CON, &B4CON, &B5CON };
+
+/** 
+ * SIDH registers of all acceptance filters (SIDL register always follows SIDH)
+ */
+volatile byte* filters[RECEIVE_FILTERS_COUNT] = { &RXF0SIDH, &RXF1SIDH, &RXF2SIDH, &RXF3SIDH, &RXF4SIDH, &RXF5SIDH, &RXF6SIDH, &RXF7SIDH, 
+    &RXF8SIDH, &RXF9SIDH, &RXF10SIDH, &RXF11SIDH, &RXF12SIDH, &RXF13SIDH, &RXF14SIDH, &RXF15SIDH };
+
+/** 
+ * SIDH registers of the acceptance masks (SIDL register always follows SIDH)
+ */
+volatile byte* masks[RECEIVE_MASKS_COUNT] = { &RXM0SIDH, &RXM1SIDH };
+
+/** 
+ * Mask select registers, each holds 2 bits (mask to use) for 4 filters
+ */
+volatile byte* maskSelects[4] = { &MSEL0, &MSEL1, &MSEL2, &MSEL3 };
+
+// EXIDEN bit in SIDL. In a mask it makes the filters check the identifier type, in a filter it has to stay 0 then to only match standard identifiers
+#define SIDL_EXIDEN 0b00001000
+// no mask to use for a filter in MSEL (filter is disabled anyway until enabled in RXFCON)
+#define NO_MASK 0b11
+
+/*
+ * Private methods
+ */
+
+void setupId(volatile byte* sidh, unsigned int id, boolean mask) {
+    // standard ID: SIDH holds bits 10..3, SIDL bits 2..0 in its top 3 bits
+    sidh[0] = (id >> 3) & MAX_8_BITS;
+    sidh[1] = ((id & 0b111) << 5) | (mask ? SIDL_EXIDEN : 0);
+}
+
+/*
+ * API methods
+ */
+
+void setupReceiveFifo() {
+    // Mode 2 = enhanced FIFO mode
+    ECANCON = 0b10000000;
+    
+    // all programmable buffers B0-B5 are receive buffers, all of them are part of the FIFO then
+    BSEL0 = 0;
+    B0CON = 0;
+    B1CON = 0;
+    B2CON = 0;
+    B3CON = 0;
+    B4CON = 0;
+    B5CON = 0;
+    RXB0CON = 0;
+    RXB1CON = 0;
+    
+    // disable all filters, only enable them as they get set up
+    RXFCON0 = 0;
+    RXFCON1 = 0;
+    for (byte i=0; i<4; i++) {
+        *maskSelects[i] = 0xFF;
+    }
+    
+    // interrupt on any receive buffer getting full
+    BIE0 = 0xFF;
+    PIE5bits.RXBnIE = 1;
+}
+
+void setupReceiveMask(byte maskNumber, unsigned int idMask) {
+    setupId(masks[maskNumber], idMask, TRUE);
+}
+
+void setupReceiveFilter15Mask(unsigned int idMask) {
+    // filter 15 acts as a mask, so the same as the masks above
+    setupId(filters[RECEIVE_FILTERS_COUNT-1], idMask, TRUE);
+}
+
+void setupReceiveFilter(byte filterNumber, byte maskNumber, CanHeader* header) {
+    setupId(filters[filterNumber], (header->messageType << 8) | header->nodeID, FALSE);
+    
+    // select the mask for the filter (2 bits per filter) and enable the filter
+    volatile byte* maskSelect = maskSelects[filterNumber >> 2];
+    byte shift = (filterNumber & 0b11) << 1;
+    *maskSelect = (*maskSelect & ~(NO_MASK << shift)) | (maskNumber << shift);
+    
+    if (filterNumber < 8) {
+        RXFCON0 |= 1 << filterNumber;
+    } else {
+        RXFCON1 |= 1 << (filterNumber - 8);
+    }
+}
+
+volatile byte* nextReceivedBuffer() {
+    // FIFO read pointer tells us which buffer to read next
+    volatile byte* buffer = receiveBuffers[CANCON & 0b111];
+    return (buffer[BUFFER_CON] & 0b10000000) ? buffer : NULL; // RXFUL bit
+}
+
+void releaseReceivedBuffer(volatile byte* buffer) {
+    buffer[BUFFER_CON] &= 0b01111111; // clear RXFUL bit
+}
+
+void disableReceiveFilter(byte filterNumber) {
+    if (filterNumber < 8) {
+        RXFCON0 &= ~(1 << filterNumber);
+    } else {
+        RXFCON1 &= ~(1 << (filterNumber - 8));
+    }
+}
@@ -0,0 +1,100 @@
+/* 
+ * Can receive covers receiving CAN messages using ECAN Mode 2 (enhanced FIFO mode). All receive buffers (RXB0, RXB1 and programmable buffers B0-B5) 
+ * form a hardware FIFO of 8 messages, so that bursts of messages are absorbed by the hardware even if the interrupt is delayed (e.g. while sending a reply).
+ * 
+ * File:   canReceive.h
+ * Author: pojd
+ *
+ * Created on November 26, 2018, 8:03 PM
+ */
+
+#ifndef CANRECEIVE_H
+#define	CANRECEIVE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <xc.h>
+#include "utils.h"
+#include "can.h"
+
+// masks of the 11 bit standard CAN ID (3 bits message type + 8 bits nodeID)
+#define FIRST_BIT_ID_MASK 0x780 // message type and first bit of nodeID (the floor) only
+#define STRICT_ID_MASK 0x7FF // whole CAN ID
+
+// number of acceptance masks and filters available in Mode 2
+#define RECEIVE_MASKS_COUNT 2
+#define RECEIVE_FILTERS_COUNT 16
+
+// in Mode 2, the last filter can be used as a third mask instead, this is its mask number for setupReceiveFilter
+#define FILTER_15_MASK 2
+
+// offsets of registers inside any receive buffer (the same layout for RXB0, RXB1 and B0-B5)
+#define BUFFER_CON 0
+#define BUFFER_SIDH 1
+#define BUFFER_SIDL 2
+#define BUFFER_DLC 5
+#define BUFFER_DATA 6
+
+/**
+ * Operations
+ */
+
+/**
+ * Switches ECAN to Mode 2 (FIFO), configures all buffers as receive buffers, disables all filters and enables the receive interrupt.
+ * Has to be called in CAN CONFIG mode, filters and masks have to be set up after this call using the methods below.
+ */
+void setupReceiveFifo();
+
+/**
+ * Sets up the acceptance mask
+ * 
+ * @param maskNumber number of the mask (0 or 1)
+ * @param idMask 11 bit mask of the standard CAN ID (1 = the bit has to match the filter)
+ */
+void setupReceiveMask(byte maskNumber, unsigned int idMask);
+
+/**
+ * Sets up filter 15 to be used as a mask (FILTER_15_MASK) instead of a filter. Filter 15 must not be set up as a filter then
+ * 
+ * @param idMask 11 bit mask of the standard CAN ID (1 = the bit has to match the filter)
+ */
+void setupReceiveFilter15Mask(unsigned int idMask);
+
+/**
+ * Sets up and enables the acceptance filter for the in passed header using the in passed mask
+ * 
+ * @param filterNumber number of the filter (0 .. RECEIVE_FILTERS_COUNT-1)
+ * @param maskNumber number of the mask to use with this filter (0, 1 or FILTER_15_MASK)
+ * @param header header (message type and nodeID) to accept
+ */
+void setupReceiveFilter(byte filterNumber, byte maskNumber, CanHeader* header);
+
+/**
+ * Disables the acceptance filter, i.e. no message would be accepted by it anymore
+ * 
+ * @param filterNumber number of the filter (0 .. RECEIVE_FILTERS_COUNT-1)
+ */
+void disableReceiveFilter(byte filterNumber);
+
+/**
+ * Gets the next message received in the FIFO (in order of receiving)
+ * 
+ * @return reference to the buffer holding the message (use BUFFER_XXX offsets to read it) or NULL if the FIFO is empty
+ */
+volatile byte* nextReceivedBuffer();
+
+/**
+ * Marks the buffer as read, i.e. frees it for the next message. The FIFO then moves on to the next buffer
+ * 
+ * @param buffer buffer as returned by nextReceivedBuffer
+ */
+void releaseReceivedBuffer(volatile byte* buffer);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* CANRECEIVE_H */
+
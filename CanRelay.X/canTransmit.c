@@ -0,0 +1,247 @@
+/* 
+ * Can transmit implementation - loads the transmit buffers directly (the same layout of registers as receive buffers) and keeps a copy of each message
+ * loaded for retries
+ * 
+ * File:   canTransmit.c
+ * Author: pojd
+ *
+ * Created on November 28, 2018, 7:58 PM
+ */
+
+#include "canTransmit.h"
+#include "canReceive.h"
+
+/** 
+ * All transmit buffers. Low priority messages only ever use the last one
+ */
+volatile byte* transmitBuffers[3] = { &TXB0CON, &TXB1CON, &TXB2CON };
+#define LOW_PRIORITY_BUFFER 2
+
+// TXREQ and TXABT bits of TXBnCON
+#define TXREQ 0b00001000
+#define TXABT 0b01000000
+
+// error state bits of COMSTAT: bus-off, transmit and receive error passive, transmit and receive warning and the warning of either
+#define ERROR_STATE_MASK 0b00111111
+
+/**
+ * Message waiting for a free transmit buffer (the message itself only holds a reference to the header, so keep the header here).
+ * The same is kept for each message in a transmit buffer, so that it can be retried
+ */
+typedef struct {
+    CanHeader header;
+    CanMessage message;
+    TransmitPriority priority;
+    byte retries; // retries done so far
+    unsigned long time; // time loaded into the transmit buffer or time not to send a retried message before
+} QueuedMessage;
+
+/** queued messages, the oldest first */
+QueuedMessage transmitQueue[TRANSMIT_QUEUE_SIZE];
+byte transmitQueueSize = 0;
+
+/** messages in the transmit buffers */
+QueuedMessage bufferMessages[3];
+/** mask of transmit buffers aborted, but not checked yet (bit 0 = TXB0), these are not free till checked */
+byte abortedBuffers = 0;
+
+/** time as of the last processTransmitQueue call, used for the messages loaded into the transmit buffers */
+unsigned long transmitTime = 0;
+
+/** number of messages dropped */
+unsigned int transmitDrops = 0;
+
+/** bus-off states seen since start, TRUE while in bus-off */
+unsigned int busOffs = 0;
+boolean busOff = FALSE;
+
+/** error states seen since last checked (COMSTAT bits) */
+volatile byte errorStates = 0;
+
+/*
+ * Private methods
+ */
+
+byte freeTransmitBuffer(TransmitPriority priority) {
+    byte first = (priority == LOW_PRIORITY) ? LOW_PRIORITY_BUFFER : 0;
+    for (byte i=first; i<3; i++) {
+        if (!(*transmitBuffers[i] & TXREQ) && !(abortedBuffers & (1 << i))) {
+            return i;
+        }
+    }
+    return NO_TRANSMIT_BUFFER;
+}
+
+void loadTransmitBuffer(byte bufferIndex, QueuedMessage* queuedMessage) {
+    // keep the message for retries
+    QueuedMessage* bufferMessage = &bufferMessages[bufferIndex];
+    *bufferMessage = *queuedMessage;
+    bufferMessage->message.header = &bufferMessage->header;
+    bufferMessage->time = transmitTime;
+    CanMessage* message = &bufferMessage->message;
+    
+    // standard ID: 3 bits of message type and 8 bits of nodeID. SIDH holds bits 10..3, SIDL bits 2..0 in its top 3 bits
+    volatile byte* buffer = transmitBuffers[bufferIndex];
+    unsigned int id = (message->header->messageType << 8) | message->header->nodeID;
+    buffer[BUFFER_SIDH] = (id >> 3) & MAX_8_BITS;
+    buffer[BUFFER_SIDL] = (id & 0b111) << 5;
+    buffer[BUFFER_DLC] = message->dataLength;
+    
+    byte* data = message->data;
+    for (byte i=0; i<message->dataLength; i++) {
+        buffer[BUFFER_DATA + i] = data[i];
+    }
+    
+    // priority and request to send at once
+    buffer[BUFFER_CON] = TXREQ | queuedMessage->priority;
+}
+
+boolean isQueued(TransmitPriority priority) {
+    for (byte i=0; i<transmitQueueSize; i++) {
+        if (transmitQueue[i].priority == priority) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+void removeFromQueue(byte index) {
+    // the queue is very small, so just move the rest
+    transmitQueueSize--;
+    for (byte j=index; j<transmitQueueSize; j++) {
+        transmitQueue[j] = transmitQueue[j+1];
+        transmitQueue[j].message.header = &transmitQueue[j].header;
+    }
+}
+
+void retryMessage(QueuedMessage* bufferMessage) {
+    // no retries in bus-off, the bus did not even get idle for the whole timeout
+    if (busOff || bufferMessage->retries == TRANSMIT_RETRIES || transmitQueueSize == TRANSMIT_QUEUE_SIZE) {
+        transmitDrops++;
+        return;
+    }
+    
+    // to the front of the queue to keep the order, to be sent after 1, 2, ... quarters
+    for (byte j=transmitQueueSize; j>0; j--) {
+        transmitQueue[j] = transmitQueue[j-1];
+        transmitQueue[j].message.header = &transmitQueue[j].header;
+    }
+    transmitQueueSize++;
+    transmitQueue[0] = *bufferMessage;
+    transmitQueue[0].message.header = &transmitQueue[0].header;
+    transmitQueue[0].time = transmitTime + (1 << bufferMessage->retries);
+    transmitQueue[0].retries++;
+}
+
+void checkTransmitBuffers() {
+    for (byte i=0; i<3; i++) {
+        volatile byte* buffer = transmitBuffers[i];
+        byte bufferMask = 1 << i;
+        
+        if (abortedBuffers & bufferMask) {
+            // aborted last time. TXREQ gets cleared only once the message being sent right now (if any) is done, only TXABT means it was not sent
+            if (*buffer & TXREQ) {
+                continue;
+            }
+            abortedBuffers &= ~bufferMask;
+            if (*buffer & TXABT) {
+                retryMessage(&bufferMessages[i]);
+            }
+        } else if ((*buffer & TXREQ) && transmitTime - bufferMessages[i].time >= TRANSMIT_TIMEOUT_QUARTERS) {
+            // not sent in time (e.g. nobody else on the bus to acknowledge it or bus-off), so abort it not to keep the buffer forever
+            *buffer &= ~TXREQ;
+            abortedBuffers |= bufferMask;
+        }
+    }
+}
+
+/*
+ * API methods
+ */
+
+boolean transmit(CanMessage* message, TransmitPriority priority) {
+    // keep the order of messages of the same priority, so only go directly to the buffer if nothing of the same priority is waiting already
+    byte bufferIndex = isQueued(priority) ? NO_TRANSMIT_BUFFER : freeTransmitBuffer(priority);
+    if (bufferIndex == NO_TRANSMIT_BUFFER && transmitQueueSize == TRANSMIT_QUEUE_SIZE) {
+        transmitDrops++;
+        return FALSE;
+    }
+    
+    QueuedMessage queuedMessage;
+    queuedMessage.header = *message->header;
+    queuedMessage.message = *message;
+    queuedMessage.priority = priority;
+    queuedMessage.retries = 0;
+    queuedMessage.time = 0;
+    
+    if (bufferIndex != NO_TRANSMIT_BUFFER) {
+        loadTransmitBuffer(bufferIndex, &queuedMessage);
+    } else {
+        transmitQueue[transmitQueueSize] = queuedMessage;
+        transmitQueue[transmitQueueSize].message.header = &transmitQueue[transmitQueueSize].header;
+        transmitQueueSize++;
+    }
+    return TRUE;
+}
+
+boolean isTransmitBufferFree(TransmitPriority priority) {
+    return (!isQueued(priority) && freeTransmitBuffer(priority) != NO_TRANSMIT_BUFFER) ? TRUE : FALSE;
+}
+
+void processTransmitQueue(unsigned long time) {
+    transmitTime = time;
+    
+    // bus-off is left by the CAN module on its own once it sees the bus idle for 128 x 11 bits
+    boolean busOffNow = COMSTATbits.TXBO;
+    if (busOffNow && !busOff) {
+        busOffs++;
+    }
+    busOff = busOffNow;
+    
+    checkTransmitBuffers();
+    
+    // high priority first, then the oldest first
+    for (byte pass=0; pass<2; pass++) {
+        TransmitPriority priority = pass ? LOW_PRIORITY : HIGH_PRIORITY;
+        
+        for (byte i=0; i<transmitQueueSize; ) {
+            QueuedMessage* queuedMessage = &transmitQueue[i];
+            if (queuedMessage->priority != priority) {
+                i++;
+                continue;
+            }
+            
+            byte bufferIndex = freeTransmitBuffer(priority);
+            if (bufferIndex == NO_TRANSMIT_BUFFER || queuedMessage->time > time) {
+                break; // no buffer for this priority or a retry backing off, keep the order and try again next time
+            }
+            loadTransmitBuffer(bufferIndex, queuedMessage);
+            removeFromQueue(i);
+        }
+    }
+}
+
+void checkCanError() {
+    if (PIR5bits.ERRIF) {
+        errorStates |= COMSTAT & ERROR_STATE_MASK;
+        PIR5bits.ERRIF = 0;
+    }
+}
+
+unsigned int getTransmitDrops() {
+    return transmitDrops;
+}
+
+unsigned int getBusOffs() {
+    return busOffs;
+}
+
+byte getErrorStates() {
+    // the current state too, so that a state lasting since before the last call is still reported
+    // read and cleared with the interrupts disabled, otherwise a state latched by the interrupt in between would get lost
+    di();
+    byte states = errorStates | (COMSTAT & ERROR_STATE_MASK);
+    errorStates = 0;
+    ei();
+    return states;
+}
@@ -0,0 +1,109 @@
+/* 
+ * Can transmit covers sending CAN messages using all 3 transmit buffers (TXB0-TXB2) with priorities. High priority messages (e.g. status replies)
+ * can use any free buffer and are always sent before low priority ones (bulk traffic, e.g. mappings replies). Low priority messages only ever occupy
+ * 1 buffer, so that there is always a free buffer left for high priority messages. Nothing here ever waits for a buffer to get free - messages that
+ * do not fit into the buffers are queued and sent later from the main loop.
+ * 
+ * Messages not sent within TRANSMIT_TIMEOUT_QUARTERS (e.g. nobody else on the bus to acknowledge them or the CAN module in bus-off) are aborted, so that
+ * a broken bus never keeps the buffers forever. Aborted messages are queued again and retried up to TRANSMIT_RETRIES times after 1, 2, ... quarters of a second,
+ * then dropped and counted. There are no retries in bus-off, the CAN module leaves it on its own once it sees the bus idle for a while. Error states
+ * of the CAN module (warning, error passive, bus-off) are kept using the error interrupt for diagnostics.
+ * 
+ * File:   canTransmit.h
+ * Author: pojd
+ *
+ * Created on November 28, 2018, 7:41 PM
+ */
+
+#ifndef CANTRANSMIT_H
+#define	CANTRANSMIT_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <xc.h>
+#include "utils.h"
+#include "can.h"
+
+/**
+ * Priority of the message to send, used directly as TXPRI bits of the transmit buffer
+ */
+typedef enum {
+    LOW_PRIORITY = 0b00, // bulk traffic
+    HIGH_PRIORITY = 0b11 // replies to be sent as soon as possible
+} TransmitPriority;
+
+// number of messages that can wait for a free transmit buffer
+#define TRANSMIT_QUEUE_SIZE 4
+// max time a message can wait in a transmit buffer in quarters of a second (so in fact 250-500ms)
+#define TRANSMIT_TIMEOUT_QUARTERS 2
+// number of retries of messages not sent in time
+#define TRANSMIT_RETRIES 2
+// marker of no transmit buffer free
+#define NO_TRANSMIT_BUFFER MAX_8_BITS
+
+/**
+ * Operations
+ */
+
+/**
+ * Sends the message - puts it directly into a free transmit buffer or queues it if no buffer is free for the priority
+ * 
+ * @param message message to send (copied, so can be reused by the caller right after this call)
+ * @param priority priority of the message
+ * @return TRUE if the message is sent or queued, FALSE if the queue was full too and the message was dropped (and counted). Messages
+ * not sent even after all retries are dropped and counted later
+ */
+boolean transmit(CanMessage* message, TransmitPriority priority);
+
+/**
+ * Checks whether a message of the in passed priority would go directly into a transmit buffer. Allows callers sending bulk traffic
+ * to only prepare the next message once it can really be sent.
+ * 
+ * @param priority priority of the message
+ * @return TRUE if a buffer is free for this priority (and no message is queued), FALSE otherwise
+ */
+boolean isTransmitBufferFree(TransmitPriority priority);
+
+/**
+ * Aborts messages not sent in time and queues them again for retries, moves queued messages to transmit buffers as they get free. 
+ * To be called regularly from the main loop
+ * 
+ * @param time actual time in quarters of a second
+ */
+void processTransmitQueue(unsigned long time);
+
+/**
+ * Checks whether the CAN module error state changed and keeps the new state for getErrorStates. To be called from the interrupt
+ */
+void checkCanError();
+
+/**
+ * Gets the number of messages dropped since start since both the buffers and the queue were full or they were not sent even after all retries
+ * 
+ * @return number of messages dropped
+ */
+unsigned int getTransmitDrops();
+
+/**
+ * Gets the number of times the CAN module went bus-off since start
+ * 
+ * @return number of bus-off states seen
+ */
+unsigned int getBusOffs();
+
+/**
+ * Gets all error states of the CAN module seen since the last call, the same bits as in COMSTAT: bus-off (0x20), transmit error passive (0x10),
+ * receive error passive (0x08), transmit warning (0x04), receive warning (0x02) and warning of either (0x01)
+ * 
+ * @return error states seen
+ */
+byte getErrorStates();
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* CANTRANSMIT_H */
+
@@ -0,0 +1,61 @@
+/* 
+ * Config queue implementation - a ring buffer with free running head and tail indexes, see operationQueue.c for details
+ * 
+ * File:   configQueue.c
+ * Author: pojd
+ *
+ * Created on December 4, 2018, 9:11 PM
+ */
+
+#include <xc.h>
+#include "configQueue.h"
+
+ReceivedConfig configs[CONFIG_QUEUE_SIZE];
+
+/** index of next entry to write (only changed by the interrupt) */
+volatile byte configsHead = 0;
+/** index of next entry to read (only changed by the main loop) */
+volatile byte configsTail = 0;
+
+/** number of CONFIG messages dropped due to the queue being full */
+volatile unsigned int configQueueOverflows = 0;
+
+boolean pushConfig(volatile byte* data, byte dataLength) {
+    if ((byte)(configsHead - configsTail) == CONFIG_QUEUE_SIZE) {
+        configQueueOverflows++;
+        return FALSE;
+    }
+    
+    // DLC can be up to 15, but never more than 8 data bytes
+    if (dataLength > CONFIG_DATA_SIZE) {
+        dataLength = CONFIG_DATA_SIZE;
+    }
+    ReceivedConfig* config = &configs[configsHead & (CONFIG_QUEUE_SIZE-1)];
+    config->dataLength = dataLength;
+    for (byte i=0; i<dataLength; i++) {
+        config->data[i] = data[i];
+    }
+    
+    // only now make the entry visible to the main loop
+    configsHead++;
+    return TRUE;
+}
+
+ReceivedConfig* peekConfig() {
+    if (configsHead == configsTail) {
+        return NULL;
+    }
+    return &configs[configsTail & (CONFIG_QUEUE_SIZE-1)];
+}
+
+void popConfig() {
+    configsTail++;
+}
+
+unsigned int getConfigQueueOverflows() {
+    // 2 bytes changed by the interrupt, so read them with the interrupts disabled
+    di();
+    unsigned int overflows = configQueueOverflows;
+    ei();
+    return overflows;
+}
@@ -0,0 +1,72 @@
+/* 
+ * Config queue is a single producer / single consumer ring buffer of CONFIG messages received over CAN (the same approach as operationQueue.h).
+ * The CAN interrupt pushes the received data and the main loop processes them in the order received, so that CONFIG messages sent in a quick
+ * sequence (e.g. bulk provisioning of mappings) are not lost while the main loop is still busy with the previous ones.
+ * 
+ * File:   configQueue.h
+ * Author: pojd
+ *
+ * Created on December 4, 2018, 9:03 PM
+ */
+
+#ifndef CONFIGQUEUE_H
+#define	CONFIGQUEUE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include "utils.h"
+
+// max data of a CAN message
+#define CONFIG_DATA_SIZE 8
+
+/**
+ * Data of one CONFIG message as received over CAN
+ */
+typedef struct {
+    byte dataLength;
+    byte data[CONFIG_DATA_SIZE];
+} ReceivedConfig;
+
+// size of the queue, has to be a power of 2 (and divide 256) since the indexes are free running bytes
+#define CONFIG_QUEUE_SIZE 8
+
+/**
+ * Operations
+ */
+
+/**
+ * Pushes data of a new CONFIG message to the end of the queue. To be called from the interrupt only (the only producer)
+ * 
+ * @param data received data
+ * @param dataLength length of the received data (DLC), only up to CONFIG_DATA_SIZE bytes are queued
+ * @return TRUE if the message was queued, FALSE if the queue was full and the message was dropped (and counted as overflow)
+ */
+boolean pushConfig(volatile byte* data, byte dataLength);
+
+/**
+ * Gets the oldest CONFIG message in the queue without removing it. To be called from the main loop only (the only consumer)
+ * 
+ * @return reference to the oldest message or NULL if the queue is empty
+ */
+ReceivedConfig* peekConfig();
+
+/**
+ * Removes the oldest CONFIG message from the queue, i.e. the one returned by peekConfig, making its space available to the interrupt again
+ */
+void popConfig();
+
+/**
+ * Gets the number of CONFIG messages dropped since start since the queue was full
+ * 
+ * @return overflow count
+ */
+unsigned int getConfigQueueOverflows();
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* CONFIGQUEUE_H */
+
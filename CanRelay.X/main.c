@@ -14,10 +14,19 @@
 #include "dao.h"
 #include "canSwitches.h"
 #include "relayMappings.h"
-
-#define BAUD_RATE 50 // speed in kbps
-#define CPU_SPEED 16 // speed in MHz
-#define FIRMWARE_VERSION 1
+#include "operationQueue.h"
+#include "configQueue.h"
+#include "canReceive.h"
+#include "canTransmit.h"
+#include "daoQueue.h"
+#include "outputPersistence.h"
+#include "relayScenes.h"
+#include "relayTimers.h"
+#include "outputNotifications.h"
+#include "relayFilters.h"
+#include "canNetwork.h"
+
+#define FIRMWARE_VERSION 4
 
 /** bucket of the floor of this node in DAO */
 #define FLOOR_DAO_BUCKET 0
@@ -25,29 +34,60 @@
 /** marker for last mapping message */
 #define MAPPINGS_END_MARKER 0xFF
 
+/** 
+ * CONFIG messages: mapping number 0 is reserved for control messages. Bulk messages carry the start mapping number followed 
+ * by 2 or 3 pairs of nodeID and output number and are only made effective by the commit control message
+ */
+#define CONFIG_CONTROL_MAPPING_NUMBER 0
+#define CONFIG_SINGLE_LENGTH 3 // mapping number, nodeID, output number
+#define CONFIG_COMMIT_LENGTH 1 // control mapping number only
+// EEPROM words queued by 1 CONFIG message at most (a single mapping with the mapping image header or a bulk message) and words left for an output snapshot
+#define CONFIG_MAX_DAO_WRITES 3
+#define CONFIG_DAO_RESERVE (OUTPUT_SNAPSHOT_SIZE / 2)
+
+/** 
+ * Control CONFIG messages with more data - second byte is the command, the rest is its value 
+ */
+#define CONFIG_COMMAND_PERSISTENCE_DELAY 1 // 2 bytes, quarters of a second, 0 = disabled
+#define CONFIG_COMMAND_SCENE_ON 2 // scene number and mask of outputs to switch on (4 bytes)
+#define CONFIG_COMMAND_SCENE_OFF 3 // scene number and mask of outputs to switch off (4 bytes)
+#define CONFIG_COMMAND_OUTPUT_TIMER 4 // output number and timer config (2 bytes: 2 bits mode, 14 bits time in quarters of a second)
+#define CONFIG_COMMAND_NOTIFICATION_WINDOW 5 // 2 bytes, quarters of a second, 0 = notifications disabled
+
+/** reports that can be requested by MAPPINGS messages (first data byte, no data means mappings too) */
+#define MAPPINGS_REPORT 0
+#define DIAGNOSTICS_REPORT 1
+#define SCENE_REPORT 2 // second data byte is the scene number
+
 /** 
  * These should be constants really (written and read from EEPROM)
  */
 
 Floor floor = GROUND; // is mandated to be set in EEPROM
+unsigned int bitRate = DEFAULT_BIT_RATE; // speed in kbps
 
 /**
  * These are control variables used by the main loop
  */
 
-/** received node ID over CAN */
-volatile byte receivedNodeID = 0;
-/** received data over CAN in the case of operations */
-volatile byte receivedDataByte = 0;
-volatile boolean receivedOperation = FALSE;
 
-/** config data - if a config CAN message was sent */
-volatile byte receivedMappingNumber = 0;
-volatile byte receivedMappingNodeID = 0;
-volatile byte receivedMappingOutputNumber = 0;
+/** new bit rate received in a network command (0 = nothing received) */
+volatile unsigned int receivedBitRate = 0;
 
-/** request for mappings received? */
+/** request for mappings received? And which report was requested then */
 volatile boolean receivedMappingsRequest = FALSE;
+volatile byte receivedReport = MAPPINGS_REPORT;
+volatile byte receivedReportArgument = 0;
+
+/** 
+ * state of sending the mappings - the mappings are sent message by message from the main loop, 
+ * so that operations are still processed in between. Index of the next mapping to send is kept here
+ */
+boolean sendingMappings = FALSE;
+byte mappingsReplyIndex = 0;
+
+/** mappings or scenes changed, so the filters of NORMAL messages have to be regenerated */
+boolean filtersOutdated = FALSE;
 
 /**
  * Timer data
@@ -64,17 +104,15 @@ void configureSpeed() {
 }
 
 void configureOutputs() {
-    // configure everything as output and set everything as 0 initially
+    // switch the outputs as they were before the power loss (all at once), still before any pin is made output (LAT written before TRIS)
+    restoreOutputs();
+    
+    // configure everything as output
     TRISA = 0;
     TRISB = 0;
     TRISC = 0;
     TRISD = 0;
     TRISE = 0;
-    PORTA = 0;
-    PORTB = 0;
-    PORTC = 0;
-    PORTD = 0;
-    PORTE = 0;
     
     // disable all analog inputs (set as digital)
     ANCON0 = 0;
@@ -91,30 +129,45 @@ void configureCan() {
     // first move to CONFIG mode
     can_setMode(CONFIG_MODE);
 
-    can_setupBaudRate(BAUD_RATE, CPU_SPEED);
+    setupBitTiming(bitRate);
+    
+    // use Mode 2 - all 8 receive buffers make up 1 hardware FIFO, so that bursts of messages are not dropped
+    setupReceiveFifo();
+    
+    // mask 0 checks message type and the first bit of nodeID (floor) only, mask 1 checks the whole CAN ID
+    setupReceiveMask(0, FIRST_BIT_ID_MASK);
+    setupReceiveMask(1, STRICT_ID_MASK);
     
-    // now setup CAN to receive only NORMAL message types for this node's floor
+    // now setup CAN to receive only NORMAL message types for nodeIDs mapped in this node's floor (see relayFilters.h)
+    setupNormalFilters(floor);
+    
+    // in addition to the above, also setup filter to receive complex message types for the same node's floor (all nodeIDs, these only come from the gateway)
     CanHeader header;
     header.nodeID = floor; // node ID = floor (first bit most important only really)
-    header.messageType = NORMAL;
-    can_setupFirstBitIdReceiveFilter(&header);
-    
-    // in addition to the above, also setup filter to receive complex message types for the same node's floor
     header.messageType = COMPLEX;
-    can_setupFirstBitIdReceiveFilter(&header);
+    setupReceiveFilter(1, 0, &header);
 
     // last piece is also config messages that canRelay now supports (only changing the mappings). It has to be a strict filter though as opposed to more vague filters above
     // since CONFIG messages can be also targeted to the individual CanSwitches, so we need to assure the nodeID is equal the floor
-    // this filter would be associated with another receive buffer with lower priority, so we need to remember checking that in can interrupt too
+    // all messages end up in the same FIFO, so the message type is checked in the can interrupt
     header.messageType = CONFIG;
-    can_setupStrictReceiveFilter(&header);
+    setupReceiveFilter(2, 1, &header);
 
     // now also register to listen to MAPPINGS requests, also strict filters
     header.messageType = MAPPINGS;
-    can_setupStrictReceiveFilter(&header);
+    setupReceiveFilter(3, 1, &header);
+
+    // and network commands sent to all nodes
+    header.nodeID = NETWORK_NODE_ID;
+    header.messageType = HEARTBEAT;
+    setupReceiveFilter(NETWORK_FILTER, 1, &header);
 
     // switch CAN to normal mode
     can_setMode(NORMAL_MODE);
+    
+    // keep the error states of the CAN module for diagnostics (see canTransmit.h)
+    PIR5bits.ERRIF = 0;
+    PIE5bits.ERRIE = 1;
 }
 
 
@@ -125,6 +178,14 @@ void configureTimer() {
     T0CON = 0b10000011;
     // enable timer interrupts
     INTCONbits.TMR0IE = 1;
+    
+    // and start timers of the outputs restored as switched on
+    OutputSet previousState;
+    clearOutputSet(&previousState);
+    updateTimers(&previousState);
+    
+    // only changes from now on are notified
+    initNotifications();
 }
 
 void configure() {
@@ -138,50 +199,53 @@ void configure() {
  * Can message processing
  */
 
-void checkCanMessageReceived() {
-    // check if CAN receive buffer 0 interrupt is enabled and interrupt flag set
-    if (PIE5bits.RXB0IE && PIR5bits.RXB0IF) {
-        // now confirm the buffer 0 is full
-        if (RXB0CONbits.RXFUL) {
-            if (RXB0DLCbits.DLC >= 1) { // make sure we received at least one byte in the CAN data frame
-                // see setupCan above for more details, but we can either get NORMAL or COMPLEX messages in buffer 0, but we process them the same way actually
-                CanHeader header = can_idToHeader(&RXB0SIDH, &RXB0SIDL);
-                // we need to know the nodeID (if it is equal to floor that the operation is for all lights)
-                receivedNodeID = header.nodeID;
-                // and we need just 1 byte of data then
-                receivedDataByte = RXB0D0;
-                // just set a flag since both of the above could actually be 0 (nodeID 0 could potentially be sent and databyte too)
-                receivedOperation = TRUE;
-            }
-            
-            RXB0CONbits.RXFUL = 0; // mark the data in buffer as read and no longer needed
-        }
-        PIR5bits.RXB0IF = 0; // clear the interrupt flag now
-    }
+void processReceivedBuffer(volatile byte* buffer) {
+    // see setupCan above for more details, but we can get NORMAL or COMPLEX messages (operations) or CONFIG or MAPPINGS messages (for this floor only)
+    CanHeader header = can_idToHeader(buffer + BUFFER_SIDH, buffer + BUFFER_SIDL);
+    byte dataLength = buffer[BUFFER_DLC] & 0b1111;
+    volatile byte* data = buffer + BUFFER_DATA;
     
-    // check if CAN receive buffer 1 interrupt is enabled and interrupt flag set
-    if (PIE5bits.RXB1IE && PIR5bits.RXB1IF) {
-        // now confirm the buffer 1 is full
-        if (RXB1CONbits.RXFUL) {
-            // see setupCan above for more details, but we can only get CONFIG or MAPPINGS messages in this buffer
-            // which makes it a bit more robust since these shall be really lower priority unlike buffer 0 anyway
-            // this time we do not need to know the nodeID since we know it is equal to floor as per setupCan where we use strict filter
-            CanHeader header = can_idToHeader(&RXB1SIDH, &RXB1SIDL);
-            if (CONFIG == header.messageType && RXB1DLCbits.DLC == 3) {
-                // in this case we expect 3 bytes of data
-                // first byte = number of the mapping - will drive address to store this at in EEPROM
-                // second byte = nodeID of the mapping
-                // last byte = output to set by this mapping (should be only up to 30 anyway)
-                receivedMappingNumber = RXB1D0;
-                receivedMappingNodeID = RXB1D1;
-                receivedMappingOutputNumber = RXB1D2;
-            } else if (MAPPINGS == header.messageType) { // in this case we do not care about data frame length
-                receivedMappingsRequest = TRUE;
+    switch (header.messageType) {
+        case NORMAL:
+        case COMPLEX:
+            if (dataLength >= 1) { // make sure we received at least one byte in the CAN data frame
+                // we process NORMAL and COMPLEX the same way actually
+                // we need to know the nodeID (if it is equal to floor that the operation is for all lights) and just 1 byte of data then
+                // queue it for the main loop, if the queue is full, the operation is dropped and counted
+                pushOperation(header.nodeID, data[0], (dataLength >= 2) ? data[1] : NO_ARGUMENT, tQuarterSecSinceStart);
             }
+            break;
+        case CONFIG:
+            if (dataLength >= 1) {
+                // queue it for the main loop, see processIncomingConfig for the format of the data
+                pushConfig(data, dataLength);
+            }
+            break;
+        case HEARTBEAT: // only network commands get here
+            if (dataLength == 3 && data[0] == NETWORK_COMMAND_BIT_RATE) {
+                receivedBitRate = (data[1] << 8) | data[2];
+            }
+            break;
+        case MAPPINGS: // in this case data frame is optional, first byte would say which report to send
+            receivedReport = (dataLength >= 1) ? data[0] : MAPPINGS_REPORT;
+            receivedReportArgument = (dataLength >= 2) ? data[1] : 0;
+            receivedMappingsRequest = TRUE;
+            break;
+    }
+}
 
-            RXB1CONbits.RXFUL = 0; // mark the data in buffer as read and no longer needed
+void checkCanMessageReceived() {
+    // check if CAN receive interrupt (any buffer) is enabled and interrupt flag set
+    if (PIE5bits.RXBnIE && PIR5bits.RXBnIF) {
+        // clear the flag first, so that any message arriving while we drain the FIFO below would trigger the interrupt again
+        PIR5bits.RXBnIF = 0;
+        
+        // now drain the whole FIFO in the order the messages were received
+        volatile byte* buffer;
+        while ( (buffer = nextReceivedBuffer()) ) {
+            processReceivedBuffer(buffer);
+            releaseReceivedBuffer(buffer); // mark the data in buffer as read and no longer needed
         }
-        PIR5bits.RXB1IF = 0; // clear the interrupt flag now
     }
 }
 
@@ -193,6 +257,7 @@ void checkTimerExpired() {
     // check if timer 0 interrupt is enabled and interrupt flag set, if so, just increase the counter of quarters of second
     if (INTCONbits.TMR0IE && INTCONbits.TMR0IF) {
         tQuarterSecSinceStart++;
+        tickTimers();
         INTCONbits.TMR0IF = 0; // clear the interrupt
     }
 }
@@ -203,6 +268,8 @@ void checkTimerExpired() {
 void interrupt handleInterrupt(void) {
     checkTimerExpired();
     checkCanMessageReceived();
+    checkCanError();
+    checkDaoWriteCompleted();
 }
 
 /*
@@ -221,31 +288,17 @@ boolean initConfigData() {
         return FALSE;
     }
     floor = dataItem.value;
+    bitRate = loadBitRate();
     
-    // now init relay mapping
+    // now init outputs (all off) and relay mapping, scenes and timers using these outputs
+    initOutputs();
     initMapping();
+    initScenes();
+    initTimers();
     
     return TRUE;
 }
 
-void performOperation (Operation operation, Output *output) {    
-    volatile byte* port = output->port;
-    byte shift = 1 << output->portBit;
-
-    // see http://stackoverflow.com/questions/47981/how-do-you-set-clear-and-toggle-a-single-bit-in-c-c
-    switch (operation) {
-        case TOGGLE:
-            *port ^= shift;
-            break;
-        case ON:
-            *port |= shift;
-            break;
-        case OFF:
-            *port &= ~shift;
-            break;
-    }
-}
-
 void sendCanMessageWithAllPorts() {
     CanHeader header;
     // set node ID to be the very first node ID on the given floor so that we can find out what relay is actually replying
@@ -264,60 +317,236 @@ void sendCanMessageWithAllPorts() {
     data[6] = RXERRCNT;
     data[7] = FIRMWARE_VERSION;
     
-    can_send(&message);
+    // status goes out before any bulk traffic
+    transmit(&message, HIGH_PRIORITY);
+}
+
+void sendCanMessageWithPortsPage(byte page) {
+    CanHeader header;
+    header.nodeID = floor;
+    header.messageType = COMPLEX_REPLY;
+    
+    CanMessage message;
+    message.header = &header;
+    
+    // switch count used, page and 24 outputs of that page (5 bytes), error registers and firmware version as in the single message
+    message.dataLength = 8;
+    byte* data = &message.data;
+    
+    retrieveOutputStatusPage(page, data);
+    data[5] = TXERRCNT;
+    data[6] = RXERRCNT;
+    data[7] = FIRMWARE_VERSION;
+    
+    transmit(&message, HIGH_PRIORITY);
 }
 
-void eraseReceivedOperationData() {
-    receivedNodeID = 0;
-    receivedDataByte = 0;
-    receivedOperation = FALSE;
+void sendCanMessagesWithStatus(byte page) {
+    byte pages = getOutputStatusPages();
+    if (page != NO_ARGUMENT) {
+        // only the page requested
+        sendCanMessageWithPortsPage(page);
+    } else if (!pages) {
+        // all outputs fit into the single message
+        sendCanMessageWithAllPorts();
+    } else {
+        // all pages right after each other
+        for (byte i=0; i<pages; i++) {
+            sendCanMessageWithPortsPage(i);
+        }
+    }
+}
+
+void processSceneOperation(Operation operation, Scene* scene) {
+    // scenes are applied as a whole, so only ON (or TOGGLE as sent by CanSwitches) makes sense
+    if (operation != OFF) {
+        OutputSet previousState;
+        getOutputState(&previousState);
+        applyScene(scene);
+        updateTimers(&previousState);
+    }
 }
 
-void processIncomingOperation() {
+void processBatchedOperation(Operation operation, ReceivedOperation* receivedOperation) {
+    // batched message from CanSwitch - the argument is a mask of the following nodeIDs (bit 0 = nodeID + 1) changed at once
+    // so expand it first and only then look up each nodeID (any of them may be a scene or not mapped at all)
+    // collect outputs of all of them to switch them in one go (the returned set is only valid till the next lookup, so copy it)
+    OutputSet batchedSet;
+    clearOutputSet(&batchedSet);
+    boolean outputsFound = FALSE;
+    byte batchedNodeIDs = receivedOperation->argument;
+    byte nodeID = receivedOperation->nodeID;
+    boolean changed = TRUE; // the nodeID of the message itself
+    while (TRUE) {
+        Scene* scene;
+        if (!changed || nodeID <= floor) {
+            // not part of the batch or not an input of a CanSwitch
+        } else if ( (scene = nodeIDToScene(nodeID)) ) {
+            processSceneOperation(operation, scene);
+        } else {
+            OutputSet* outputSet = nodeIDToOutputs(nodeID, receivedOperation->timestamp);
+            if (outputSet) {
+                for (byte i=0; i<PORTS_COUNT; i++) {
+                    batchedSet.masks[i] |= outputSet->masks[i];
+                }
+                outputsFound = TRUE;
+            }
+        }
+        if (!batchedNodeIDs) {
+            break;
+        }
+        changed = batchedNodeIDs & 1;
+        batchedNodeIDs >>= 1;
+        nodeID++;
+    }
+    if (outputsFound) {
+        performTimedOperation (operation, &batchedSet);
+    }
+}
+
+void processIncomingOperation(ReceivedOperation* receivedOperation) {
     // first take the operation from the data byte
-    Operation operation = can_extractOperationFromDataByte(receivedDataByte);
+    Operation operation = can_extractOperationFromDataByte(receivedOperation->dataByte);
+    byte receivedNodeID = receivedOperation->nodeID;
     
     if (operation == GET) {
-        eraseReceivedOperationData(); // we no longer need the message and can allow other messages to be received
-        sendCanMessageWithAllPorts();
+        sendCanMessagesWithStatus(receivedOperation->argument);
     } else { // other operations are setting things up
+        Scene* scene;
         // we should only receive nodeIDs >= floor
-        if (receivedNodeID > floor) {
-            // use the mapping routine to get output (port, bit) to change using the received nodeID
-            // for example for nodeID 5 we need to change say PORTB, bit 2
-            // pass in also the current time since the method internally also checks for too fast operations for a given output
-            Output* output = nodeIDToOutput(receivedNodeID, tQuarterSecSinceStart);
+        if (receivedOperation->argument != NO_ARGUMENT) {
+            processBatchedOperation(operation, receivedOperation);
+        } else if ( (scene = nodeIDToScene(receivedNodeID)) ) {
+            processSceneOperation(operation, scene);
+        } else if (receivedNodeID > floor) {
+            // use the mapping routine to get outputs (port masks) to change using the received nodeID
+            // for example for nodeID 5 we need to change say PORTB, bit 2 and PORTD, bit 7
+            // pass in also the time of receiving the operation since the method internally also checks for too fast operations for a given output
+            OutputSet* outputSet = nodeIDToOutputs(receivedNodeID, receivedOperation->timestamp);
             // we may have received unknown or not mapped nodeID, in that case do nothing
-            // or it may be too soon after last message for this output
-            if (output) { 
-                performOperation (operation, output);
+            // or it may be too soon after last message for these outputs
+            if (outputSet) { 
+                performTimedOperation (operation, outputSet);
             }
         } else if (receivedNodeID == floor) {
             // in this case do the same operations as above, but for all really used outputs
             // in this case the internal time for the outputs is not used, so this operation can be invoked very fast via CAN API
-            UsedOutputs* outputs = getUsedOutputs();
-            Output *o = outputs->array;
-            Output *oEnd = outputs->array + outputs->size;
-            for (; o < oEnd; o++) {
-                performOperation (operation, o);                
-            }
+            // all outputs are switched at once (one write per port)
+            performTimedOperation (operation, getUsedOutputSet());
         } // < floor should never happen, in case it does, do nothing, probably missconfigured CAN filters
-        eraseReceivedOperationData();
     }
 }
 
-void eraseReceivedConfigData() {
-    receivedMappingNumber = 0;
-    receivedMappingNodeID = 0;
-    receivedMappingOutputNumber = 0;
+void processIncomingOperations() {
+    // drain all operations received so far in the order they were received
+    ReceivedOperation* receivedOperation;
+    while ( (receivedOperation = peekOperation()) ) {
+        processIncomingOperation(receivedOperation);
+        popOperation(); // only now free the entry for the interrupt
+    }
 }
 
-void sendOneCanMessageWithMappings(CanMessage* message, byte dataLength) {
-    message->dataLength = dataLength;
-    can_sendSynchronous(message);
+/**
+ * Stores the new bit rate and switches CAN to it right away (all nodes received the same network command at the same time)
+ */
+void useBitRate(unsigned int newBitRate) {
+    bitRate = newBitRate;
+    can_setMode(CONFIG_MODE);
+    setupBitTiming(bitRate);
+    can_setMode(NORMAL_MODE);
+}
+
+void switchBitRate(unsigned int newBitRate) {
+    // only on trial first, stored once the bus works on the new bit rate (see canNetwork.h)
+    if (startBitRateTrial(bitRate, newBitRate, tQuarterSecSinceStart)) {
+        useBitRate(newBitRate);
+    }
+}
+
+/**
+ * Regenerates the filters of NORMAL messages after mappings or scenes changed. CAN has to be switched to CONFIG mode for that for a moment,
+ * i.e. the relay is off the bus meanwhile, so only done once for all CONFIG messages received in a row (see processIncomingConfigs)
+ */
+void reconfigureNormalFilters() {
+    can_setMode(CONFIG_MODE);
+    setupNormalFilters(floor);
+    can_setMode(NORMAL_MODE);
+}
+
+void processIncomingConfig(ReceivedConfig* receivedConfig) {
+    byte* data = receivedConfig->data;
+    byte dataLength = receivedConfig->dataLength;
+    
+    if (data[0] == CONFIG_CONTROL_MAPPING_NUMBER) {
+        if (dataLength == CONFIG_COMMIT_LENGTH) {
+            // commit - make all bulk mappings received so far effective
+            commitMappings();
+            filtersOutdated = TRUE;
+        } else {
+            switch (data[1]) {
+                case CONFIG_COMMAND_PERSISTENCE_DELAY:
+                    if (dataLength == 4) {
+                        setPersistenceDelay((data[2] << 8) | data[3]);
+                    }
+                    break;
+                case CONFIG_COMMAND_SCENE_ON:
+                case CONFIG_COMMAND_SCENE_OFF:
+                    if (dataLength == 3 + SCENE_MASK_SIZE) {
+                        updateScene(data[2], data[1] == CONFIG_COMMAND_SCENE_ON, data + 3);
+                        filtersOutdated = TRUE;
+                    }
+                    break;
+                case CONFIG_COMMAND_OUTPUT_TIMER:
+                    if (dataLength == 5) {
+                        setOutputTimer(data[2], data[3] >> 6, ((data[3] << 8) | data[4]) & MAX_TIMER_TIME);
+                    }
+                    break;
+                case CONFIG_COMMAND_NOTIFICATION_WINDOW:
+                    if (dataLength == 4) {
+                        setNotificationWindow((data[2] << 8) | data[3]);
+                    }
+                    break;
+            }
+        }
+    } else if (dataLength == CONFIG_SINGLE_LENGTH) {
+        // first byte = number of the mapping - will drive address to store this at in EEPROM
+        // second byte = nodeID of the mapping
+        // last byte = output to set by this mapping (should be only up to 30 anyway)
+        // effective right away
+        updateMapping(data[0], data[1], data[2]);
+        filtersOutdated = TRUE;
+    } else if (dataLength > CONFIG_SINGLE_LENGTH && (dataLength & 1)) {
+        // bulk - first byte = number of the first mapping, then pairs of nodeID and output number for this and the following mappings
+        byte mappingNumber = data[0];
+        for (byte i=1; i<dataLength && mappingNumber; i+=2, mappingNumber++) {
+            stageMapping(mappingNumber, data[i], data[i+1]);
+        }
+    }
 }
 
-void sendCanMessagesWithAllMappings() {
+void processIncomingConfigs() {
+    // only take the next message once all its EEPROM writes fit into the DAO queue, so that the main loop never waits for EEPROM.
+    // The messages wait in the config queue meanwhile
+    ReceivedConfig* receivedConfig;
+    while ( getDaoQueueSpace() >= CONFIG_MAX_DAO_WRITES + CONFIG_DAO_RESERVE && (receivedConfig = peekConfig()) ) {
+        processIncomingConfig(receivedConfig);
+        popConfig(); // only now free the entry for the interrupt
+    }
+    
+    // filters only once all CONFIG messages received so far are processed
+    if (filtersOutdated && !peekConfig()) {
+        reconfigureNormalFilters();
+        filtersOutdated = FALSE;
+    }
+}
+
+void startSendingAllMappings() {
+    // (re)start from the very first mapping, the messages would then be sent one by one from the main loop
+    mappingsReplyIndex = 0;
+    sendingMappings = TRUE;
+}
+
+void sendNextCanMessageWithMappings() {
     CanHeader header;
     header.nodeID = floor;
     header.messageType = MAPPINGS_REPLY;
@@ -326,31 +555,93 @@ void sendCanMessagesWithAllMappings() {
     message.header = &header;
     byte* data = &message.data;
     
-    // now loop through all the mappings, split it to chunks of 8 bytes top per messages and send all the messages with mappings, no size now
+    // take next mappings (from where we stopped last time), split it to chunks of 8 bytes top per message, no size now
     Mappings* mappings = getRuntimeMappings();
-    Mapping *m = mappings->array;
-    Mapping *mEnd = mappings->array + mappings->size;
-    
     byte dataLength = 0;
-    for (; m < mEnd; m++) {
+    
+    for (; mappingsReplyIndex < mappings->size && dataLength < 8; mappingsReplyIndex++) {
+        Mapping *m = &mappings->array[mappingsReplyIndex];
         *data++ = m->nodeID;
         *data++ = m->outputNumber;
         dataLength += 2;
-        if (dataLength == 8) {
-            // we have enough data to send can message, so send it now and reset data pointer to start from data 0 again
-            sendOneCanMessageWithMappings(&message, dataLength);
-            dataLength = 0;
-            data = &message.data;
-        }
     }
     
-    // append 2 markers (so that we always see pairs of numbers)
-    // and any clients listening to this traffic would know that this is the last message
-    // we may have some residual data already from the above loop, but 6 bytes top, so we can add 2 more
-    *data++ = MAPPINGS_END_MARKER;
-    *data++= MAPPINGS_END_MARKER;
-    dataLength+=2;    
-    sendOneCanMessageWithMappings(&message, dataLength);
+    if (dataLength < 8) {
+        // all mappings are in, so append 2 markers (so that we always see pairs of numbers)
+        // and any clients listening to this traffic would know that this is the last message
+        // we may have some residual data already from the above loop, but 6 bytes top, so we can add 2 more
+        // (if the last mappings filled in the whole message, the markers would be sent alone in the next message)
+        *data++ = MAPPINGS_END_MARKER;
+        *data++= MAPPINGS_END_MARKER;
+        dataLength+=2;
+        sendingMappings = FALSE;
+    }
+    
+    message.dataLength = dataLength;
+    transmit(&message, LOW_PRIORITY);
+}
+
+void sendCanMessageWithNotification(byte* notification) {
+    CanHeader header;
+    // the node ID right after the floor, so that it is not mixed with replies to GET
+    header.nodeID = floor + NOTIFICATION_NODEID_OFFSET;
+    header.messageType = COMPLEX_REPLY;
+    
+    CanMessage message;
+    message.header = &header;
+    message.dataLength = NOTIFICATION_SIZE;
+    byte* data = &message.data;
+    for (byte i=0; i<NOTIFICATION_SIZE; i++) {
+        data[i] = notification[i];
+    }
+    
+    transmit(&message, HIGH_PRIORITY);
+}
+
+void sendCanMessageWithScene(byte sceneNumber) {
+    CanHeader header;
+    header.nodeID = floor;
+    header.messageType = MAPPINGS_REPLY;
+    
+    CanMessage message;
+    message.header = &header;
+    byte* data = &message.data;
+    
+    // on mask followed by off mask, nothing is sent for unknown scenes
+    if (retrieveScene(sceneNumber, data)) {
+        message.dataLength = SCENE_SIZE;
+        transmit(&message, HIGH_PRIORITY);
+    }
+}
+
+void sendCanMessageWithDiagnostics() {
+    CanHeader header;
+    header.nodeID = floor;
+    header.messageType = MAPPINGS_REPLY;
+    
+    CanMessage message;
+    message.header = &header;
+    byte* data = &message.data;
+    
+    // operations dropped since start because the operation queue was full (2 bytes)
+    unsigned int operationQueueOverflows = getOperationQueueOverflows();
+    *data++ = (operationQueueOverflows >> 8) & MAX_8_BITS;
+    *data++ = operationQueueOverflows & MAX_8_BITS;
+    // messages dropped since start because no transmit buffer was free and the transmit queue was full or not sent even after all retries (2 bytes)
+    unsigned int transmitDrops = getTransmitDrops();
+    *data++ = (transmitDrops >> 8) & MAX_8_BITS;
+    *data++ = transmitDrops & MAX_8_BITS;
+    // CONFIG messages dropped since start because the config queue was full (2 bytes)
+    unsigned int configQueueOverflows = getConfigQueueOverflows();
+    *data++ = (configQueueOverflows >> 8) & MAX_8_BITS;
+    *data++ = configQueueOverflows & MAX_8_BITS;
+    // bus-off states seen since start (capped at 1 byte) and CAN error states seen since the last diagnostics (see canTransmit.h)
+    unsigned int busOffs = getBusOffs();
+    *data++ = (busOffs > MAX_8_BITS) ? MAX_8_BITS : busOffs;
+    *data++ = getErrorStates();
+    message.dataLength = 8;
+    
+    transmit(&message, HIGH_PRIORITY);
 }
 
 
@@ -369,21 +660,55 @@ int main(void) {
     
     // main loop
     while (TRUE) {
-        // received a message over CAN, so react to that - use the flag to detect am operation was received
-        if (receivedOperation) {
-            processIncomingOperation();
-        }
+        // received operations over CAN, so react to that
+        processIncomingOperations();
 
-        if (receivedMappingNumber) {
-            // let the mapping do the magic
-            updateMapping(receivedMappingNumber, receivedMappingNodeID, receivedMappingOutputNumber);
-            eraseReceivedConfigData();
+        if (receivedBitRate) {
+            switchBitRate(receivedBitRate);
+            receivedBitRate = 0;
         }
+        // back to the previous bit rate if some node did not switch
+        unsigned int previousBitRate = checkBitRateTrial(tQuarterSecSinceStart);
+        if (previousBitRate) {
+            useBitRate(previousBitRate);
+        }
+        
+        // received CONFIG messages, so let the mapping do the magic
+        processIncomingConfigs();
         
         if (receivedMappingsRequest) {
             receivedMappingsRequest = FALSE;
-            sendCanMessagesWithAllMappings();
+            if (receivedReport == DIAGNOSTICS_REPORT) {
+                sendCanMessageWithDiagnostics();
+            } else if (receivedReport == SCENE_REPORT) {
+                sendCanMessageWithScene(receivedReportArgument);
+            } else {
+                startSendingAllMappings();
+            }
+        }
+        
+        // send next message with mappings, but only once the previous message is sent, never wait for that
+        if (sendingMappings && isTransmitBufferFree(LOW_PRIORITY)) {
+            sendNextCanMessageWithMappings();
         }
+        
+        // and send anything waiting for a free transmit buffer
+        processTransmitQueue(tQuarterSecSinceStart);
+        
+        // switch off outputs with timers expired
+        processTimers();
+        
+        // let others know about changed outputs (if enabled)
+        byte notification[NOTIFICATION_SIZE];
+        if (nextNotification(tQuarterSecSinceStart, notification)) {
+            sendCanMessageWithNotification(notification);
+        }
+        
+        // keep the status of outputs in EEPROM once it is stable
+        processOutputPersistence(tQuarterSecSinceStart);
+        
+        // write next byte of updated mappings or output status into EEPROM if the previous one is written already
+        processDaoQueue();
     }
     
     return 0;
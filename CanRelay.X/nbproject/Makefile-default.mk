@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../../piclib/can.c ../../piclib/dao.c main.c relayMappings.c
+SOURCEFILES_QUOTED_IF_SPACED=../../piclib/can.c ../../piclib/dao.c main.c relayMappings.c relayOutputs.c operationQueue.c canReceive.c canTransmit.c ../CanSetup.X/daoQueue.c configQueue.c outputPersistence.c relayScenes.c relayTimers.c outputNotifications.c relayFilters.c ../CanSetup.X/canNetwork.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/962885029/can.p1 ${OBJECTDIR}/_ext/962885029/dao.p1 ${OBJECTDIR}/main.p1 ${OBJECTDIR}/relayMappings.p1
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/962885029/can.p1.d ${OBJECTDIR}/_ext/962885029/dao.p1.d ${OBJECTDIR}/main.p1.d ${OBJECTDIR}/relayMappings.p1.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/962885029/can.p1 ${OBJECTDIR}/_ext/962885029/dao.p1 ${OBJECTDIR}/main.p1 ${OBJECTDIR}/relayMappings.p1 ${OBJECTDIR}/relayOutputs.p1 ${OBJECTDIR}/operationQueue.p1 ${OBJECTDIR}/canReceive.p1 ${OBJECTDIR}/canTransmit.p1 ${OBJECTDIR}/_ext/948908131/daoQueue.p1 ${OBJECTDIR}/configQueue.p1 ${OBJECTDIR}/outputPersistence.p1 ${OBJECTDIR}/relayScenes.p1 ${OBJECTDIR}/relayTimers.p1 ${OBJECTDIR}/outputNotifications.p1 ${OBJECTDIR}/relayFilters.p1 ${OBJECTDIR}/_ext/948908131/canNetwork.p1
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/962885029/can.p1.d ${OBJECTDIR}/_ext/962885029/dao.p1.d ${OBJECTDIR}/main.p1.d ${OBJECTDIR}/relayMappings.p1.d ${OBJECTDIR}/relayOutputs.p1.d ${OBJECTDIR}/operationQueue.p1.d ${OBJECTDIR}/canReceive.p1.d ${OBJECTDIR}/canTransmit.p1.d ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d ${OBJECTDIR}/configQueue.p1.d ${OBJECTDIR}/outputPersistence.p1.d ${OBJECTDIR}/relayScenes.p1.d ${OBJECTDIR}/relayTimers.p1.d ${OBJECTDIR}/outputNotifications.p1.d ${OBJECTDIR}/relayFilters.p1.d ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/962885029/can.p1 ${OBJECTDIR}/_ext/962885029/dao.p1 ${OBJECTDIR}/main.p1 ${OBJECTDIR}/relayMappings.p1
+OBJECTFILES=${OBJECTDIR}/_ext/962885029/can.p1 ${OBJECTDIR}/_ext/962885029/dao.p1 ${OBJECTDIR}/main.p1 ${OBJECTDIR}/relayMappings.p1 ${OBJECTDIR}/relayOutputs.p1 ${OBJECTDIR}/operationQueue.p1 ${OBJECTDIR}/canReceive.p1 ${OBJECTDIR}/canTransmit.p1 ${OBJECTDIR}/_ext/948908131/daoQueue.p1 ${OBJECTDIR}/configQueue.p1 ${OBJECTDIR}/outputPersistence.p1 ${OBJECTDIR}/relayScenes.p1 ${OBJECTDIR}/relayTimers.p1 ${OBJECTDIR}/outputNotifications.p1 ${OBJECTDIR}/relayFilters.p1 ${OBJECTDIR}/_ext/948908131/canNetwork.p1
 
 # Source Files
-SOURCEFILES=../../piclib/can.c ../../piclib/dao.c main.c relayMappings.c
+SOURCEFILES=../../piclib/can.c ../../piclib/dao.c main.c relayMappings.c relayOutputs.c operationQueue.c canReceive.c canTransmit.c ../CanSetup.X/daoQueue.c configQueue.c outputPersistence.c relayScenes.c relayTimers.c outputNotifications.c relayFilters.c ../CanSetup.X/canNetwork.c
 
 
 CFLAGS=
@@ -117,6 +117,102 @@ ${OBJECTDIR}/main.p1: main.c  nbproject/Makefile-${CND_CONF}.mk
 	@-${MV} ${OBJECTDIR}/main.d ${OBJECTDIR}/main.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/main.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/948908131/canNetwork.p1: ../CanSetup.X/canNetwork.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/948908131" 
+	@${RM} ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/948908131/canNetwork.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/_ext/948908131/canNetwork.p1 ../CanSetup.X/canNetwork.c 
+	@-${MV} ${OBJECTDIR}/_ext/948908131/canNetwork.d ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/relayFilters.p1: relayFilters.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/relayFilters.p1.d 
+	@${RM} ${OBJECTDIR}/relayFilters.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/relayFilters.p1 relayFilters.c 
+	@-${MV} ${OBJECTDIR}/relayFilters.d ${OBJECTDIR}/relayFilters.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/relayFilters.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/outputNotifications.p1: outputNotifications.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/outputNotifications.p1.d 
+	@${RM} ${OBJECTDIR}/outputNotifications.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/outputNotifications.p1 outputNotifications.c 
+	@-${MV} ${OBJECTDIR}/outputNotifications.d ${OBJECTDIR}/outputNotifications.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/outputNotifications.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/relayTimers.p1: relayTimers.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/relayTimers.p1.d 
+	@${RM} ${OBJECTDIR}/relayTimers.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/relayTimers.p1 relayTimers.c 
+	@-${MV} ${OBJECTDIR}/relayTimers.d ${OBJECTDIR}/relayTimers.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/relayTimers.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/relayScenes.p1: relayScenes.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/relayScenes.p1.d 
+	@${RM} ${OBJECTDIR}/relayScenes.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/relayScenes.p1 relayScenes.c 
+	@-${MV} ${OBJECTDIR}/relayScenes.d ${OBJECTDIR}/relayScenes.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/relayScenes.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/outputPersistence.p1: outputPersistence.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/outputPersistence.p1.d 
+	@${RM} ${OBJECTDIR}/outputPersistence.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/outputPersistence.p1 outputPersistence.c 
+	@-${MV} ${OBJECTDIR}/outputPersistence.d ${OBJECTDIR}/outputPersistence.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/outputPersistence.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/configQueue.p1: configQueue.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/configQueue.p1.d 
+	@${RM} ${OBJECTDIR}/configQueue.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/configQueue.p1 configQueue.c 
+	@-${MV} ${OBJECTDIR}/configQueue.d ${OBJECTDIR}/configQueue.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/configQueue.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/948908131/daoQueue.p1: ../CanSetup.X/daoQueue.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/948908131" 
+	@${RM} ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/948908131/daoQueue.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/_ext/948908131/daoQueue.p1 ../CanSetup.X/daoQueue.c 
+	@-${MV} ${OBJECTDIR}/_ext/948908131/daoQueue.d ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/canTransmit.p1: canTransmit.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/canTransmit.p1.d 
+	@${RM} ${OBJECTDIR}/canTransmit.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/canTransmit.p1 canTransmit.c 
+	@-${MV} ${OBJECTDIR}/canTransmit.d ${OBJECTDIR}/canTransmit.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/canTransmit.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/canReceive.p1: canReceive.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/canReceive.p1.d 
+	@${RM} ${OBJECTDIR}/canReceive.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/canReceive.p1 canReceive.c 
+	@-${MV} ${OBJECTDIR}/canReceive.d ${OBJECTDIR}/canReceive.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/canReceive.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/operationQueue.p1: operationQueue.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/operationQueue.p1.d 
+	@${RM} ${OBJECTDIR}/operationQueue.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/operationQueue.p1 operationQueue.c 
+	@-${MV} ${OBJECTDIR}/operationQueue.d ${OBJECTDIR}/operationQueue.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/operationQueue.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/relayOutputs.p1: relayOutputs.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/relayOutputs.p1.d 
+	@${RM} ${OBJECTDIR}/relayOutputs.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/relayOutputs.p1 relayOutputs.c 
+	@-${MV} ${OBJECTDIR}/relayOutputs.d ${OBJECTDIR}/relayOutputs.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/relayOutputs.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/relayMappings.p1: relayMappings.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}" 
 	@${RM} ${OBJECTDIR}/relayMappings.p1.d 
@@ -150,6 +246,102 @@ ${OBJECTDIR}/main.p1: main.c  nbproject/Makefile-${CND_CONF}.mk
 	@-${MV} ${OBJECTDIR}/main.d ${OBJECTDIR}/main.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/main.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/948908131/canNetwork.p1: ../CanSetup.X/canNetwork.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/948908131" 
+	@${RM} ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/948908131/canNetwork.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/_ext/948908131/canNetwork.p1 ../CanSetup.X/canNetwork.c 
+	@-${MV} ${OBJECTDIR}/_ext/948908131/canNetwork.d ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/relayFilters.p1: relayFilters.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/relayFilters.p1.d 
+	@${RM} ${OBJECTDIR}/relayFilters.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/relayFilters.p1 relayFilters.c 
+	@-${MV} ${OBJECTDIR}/relayFilters.d ${OBJECTDIR}/relayFilters.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/relayFilters.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/outputNotifications.p1: outputNotifications.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/outputNotifications.p1.d 
+	@${RM} ${OBJECTDIR}/outputNotifications.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/outputNotifications.p1 outputNotifications.c 
+	@-${MV} ${OBJECTDIR}/outputNotifications.d ${OBJECTDIR}/outputNotifications.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/outputNotifications.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/relayTimers.p1: relayTimers.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/relayTimers.p1.d 
+	@${RM} ${OBJECTDIR}/relayTimers.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/relayTimers.p1 relayTimers.c 
+	@-${MV} ${OBJECTDIR}/relayTimers.d ${OBJECTDIR}/relayTimers.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/relayTimers.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/relayScenes.p1: relayScenes.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/relayScenes.p1.d 
+	@${RM} ${OBJECTDIR}/relayScenes.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/relayScenes.p1 relayScenes.c 
+	@-${MV} ${OBJECTDIR}/relayScenes.d ${OBJECTDIR}/relayScenes.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/relayScenes.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/outputPersistence.p1: outputPersistence.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/outputPersistence.p1.d 
+	@${RM} ${OBJECTDIR}/outputPersistence.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/outputPersistence.p1 outputPersistence.c 
+	@-${MV} ${OBJECTDIR}/outputPersistence.d ${OBJECTDIR}/outputPersistence.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/outputPersistence.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/configQueue.p1: configQueue.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/configQueue.p1.d 
+	@${RM} ${OBJECTDIR}/configQueue.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/configQueue.p1 configQueue.c 
+	@-${MV} ${OBJECTDIR}/configQueue.d ${OBJECTDIR}/configQueue.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/configQueue.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/948908131/daoQueue.p1: ../CanSetup.X/daoQueue.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/948908131" 
+	@${RM} ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/948908131/daoQueue.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/_ext/948908131/daoQueue.p1 ../CanSetup.X/daoQueue.c 
+	@-${MV} ${OBJECTDIR}/_ext/948908131/daoQueue.d ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/canTransmit.p1: canTransmit.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/canTransmit.p1.d 
+	@${RM} ${OBJECTDIR}/canTransmit.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/canTransmit.p1 canTransmit.c 
+	@-${MV} ${OBJECTDIR}/canTransmit.d ${OBJECTDIR}/canTransmit.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/canTransmit.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/canReceive.p1: canReceive.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/canReceive.p1.d 
+	@${RM} ${OBJECTDIR}/canReceive.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/canReceive.p1 canReceive.c 
+	@-${MV} ${OBJECTDIR}/canReceive.d ${OBJECTDIR}/canReceive.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/canReceive.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/operationQueue.p1: operationQueue.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/operationQueue.p1.d 
+	@${RM} ${OBJECTDIR}/operationQueue.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/operationQueue.p1 operationQueue.c 
+	@-${MV} ${OBJECTDIR}/operationQueue.d ${OBJECTDIR}/operationQueue.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/operationQueue.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/relayOutputs.p1: relayOutputs.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/relayOutputs.p1.d 
+	@${RM} ${OBJECTDIR}/relayOutputs.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/relayOutputs.p1 relayOutputs.c 
+	@-${MV} ${OBJECTDIR}/relayOutputs.d ${OBJECTDIR}/relayOutputs.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/relayOutputs.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/relayMappings.p1: relayMappings.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}" 
 	@${RM} ${OBJECTDIR}/relayMappings.p1.d 
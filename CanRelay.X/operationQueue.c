@@ -0,0 +1,62 @@
+/* 
+ * Operation queue implementation - a ring buffer with free running head and tail indexes.
+ * 
+ * Only the interrupt ever writes the head and only the main loop ever writes the tail. Both are single bytes, so written atomically
+ * and no interrupts need to be disabled (only to read the 2 byte overflow count). The entry is always written before the head is moved and read
+ * before the tail is moved.
+ * 
+ * File:   operationQueue.c
+ * Author: pojd
+ *
+ * Created on November 25, 2018, 4:52 PM
+ */
+
+#include <xc.h>
+#include "operationQueue.h"
+
+ReceivedOperation operations[OPERATION_QUEUE_SIZE];
+
+/** index of next entry to write (only changed by the interrupt) */
+volatile byte operationsHead = 0;
+/** index of next entry to read (only changed by the main loop) */
+volatile byte operationsTail = 0;
+
+/** number of operations dropped due to the queue being full */
+volatile unsigned int operationQueueOverflows = 0;
+
+boolean pushOperation(byte nodeID, byte dataByte, byte argument, unsigned long timestamp) {
+    // indexes are free running, so their difference is the number of entries in the queue (even after they overflow)
+    if ((byte)(operationsHead - operationsTail) == OPERATION_QUEUE_SIZE) {
+        operationQueueOverflows++;
+        return FALSE;
+    }
+    
+    ReceivedOperation* operation = &operations[operationsHead & (OPERATION_QUEUE_SIZE-1)];
+    operation->nodeID = nodeID;
+    operation->dataByte = dataByte;
+    operation->argument = argument;
+    operation->timestamp = timestamp;
+    
+    // only now make the entry visible to the main loop
+    operationsHead++;
+    return TRUE;
+}
+
+ReceivedOperation* peekOperation() {
+    if (operationsHead == operationsTail) {
+        return NULL;
+    }
+    return &operations[operationsTail & (OPERATION_QUEUE_SIZE-1)];
+}
+
+void popOperation() {
+    operationsTail++;
+}
+
+unsigned int getOperationQueueOverflows() {
+    // 2 bytes changed by the interrupt, so read them with the interrupts disabled
+    di();
+    unsigned int overflows = operationQueueOverflows;
+    ei();
+    return overflows;
+}
@@ -0,0 +1,75 @@
+/* 
+ * Operation queue is a single producer / single consumer ring buffer of operations received over CAN. The CAN interrupt pushes the received
+ * operations and the main loop drains them in the order received, so that no operation is lost if more arrive before the main loop gets to them.
+ * 
+ * File:   operationQueue.h
+ * Author: pojd
+ *
+ * Created on November 25, 2018, 4:37 PM
+ */
+
+#ifndef OPERATIONQUEUE_H
+#define	OPERATIONQUEUE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include "utils.h"
+
+/**
+ * One operation as received over CAN
+ */
+typedef struct {
+    byte nodeID; // nodeID as received on the wire (if it is equal to floor that the operation is for all lights)
+    byte dataByte; // first data byte, carries the operation
+    byte argument; // second data byte if any (e.g. page of the status for GET), NO_ARGUMENT otherwise
+    unsigned long timestamp; // time of receiving the operation in quarters of a second
+} ReceivedOperation;
+
+// marker of no second data byte received
+#define NO_ARGUMENT MAX_8_BITS
+
+// size of the queue, has to be a power of 2 (and divide 256) since the indexes are free running bytes
+#define OPERATION_QUEUE_SIZE 16
+
+/**
+ * Operations
+ */
+
+/**
+ * Pushes a new operation to the end of the queue. To be called from the interrupt only (the only producer)
+ * 
+ * @param nodeID received nodeID
+ * @param dataByte received first data byte
+ * @param argument received second data byte or NO_ARGUMENT
+ * @param timestamp time of receiving the operation
+ * @return TRUE if the operation was queued, FALSE if the queue was full and the operation was dropped (and counted as overflow)
+ */
+boolean pushOperation(byte nodeID, byte dataByte, byte argument, unsigned long timestamp);
+
+/**
+ * Gets the oldest operation in the queue without removing it. To be called from the main loop only (the only consumer)
+ * 
+ * @return reference to the oldest operation or NULL if the queue is empty
+ */
+ReceivedOperation* peekOperation();
+
+/**
+ * Removes the oldest operation from the queue, i.e. the one returned by peekOperation, making its space available to the interrupt again
+ */
+void popOperation();
+
+/**
+ * Gets the number of operations dropped since start since the queue was full
+ * 
+ * @return overflow count
+ */
+unsigned int getOperationQueueOverflows();
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* OPERATIONQUEUE_H */
+
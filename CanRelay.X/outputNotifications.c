@@ -0,0 +1,86 @@
+/* 
+ * Output notifications implementation - compares the status of outputs with the status last notified from the main loop
+ * 
+ * File:   outputNotifications.c
+ * Author: pojd
+ *
+ * Created on December 12, 2018, 9:36 PM
+ */
+
+#include "outputNotifications.h"
+#include "daoQueue.h"
+
+/** current notification window in quarters of a second */
+unsigned int notificationWindow = NOTIFICATIONS_DISABLED;
+
+/** status of outputs last notified */
+OutputSet notifiedState;
+
+/** sequence number of the next notification */
+byte notificationSequence = 0;
+
+/** is the window open (i.e. something changed and the notification is not sent yet) and since when */
+boolean notificationPending = FALSE;
+unsigned long notificationWindowStart = 0;
+
+/*
+ * API methods
+ */
+
+void initNotifications() {
+    byte window[2];
+    readEeprom(NOTIFICATION_WINDOW_ADDRESS, window, 2);
+    notificationWindow = (window[0] << 8) | window[1];
+    if (notificationWindow == 0xFFFF) {
+        notificationWindow = NOTIFICATIONS_DISABLED; // never set
+    }
+    getOutputState(&notifiedState);
+}
+
+boolean nextNotification(unsigned long time, byte* data) {
+    if (notificationWindow == NOTIFICATIONS_DISABLED) {
+        return FALSE;
+    }
+    
+    OutputSet state, changed;
+    getOutputState(&state);
+    byte anyChanged = 0;
+    for (byte i=0; i<PORTS_COUNT; i++) {
+        changed.masks[i] = state.masks[i] ^ notifiedState.masks[i];
+        anyChanged |= changed.masks[i];
+    }
+    
+    if (!notificationPending) {
+        if (anyChanged) {
+            // first change, so open the window now
+            notificationPending = TRUE;
+            notificationWindowStart = time;
+        }
+        return FALSE;
+    }
+    
+    if ((time - notificationWindowStart) < notificationWindow) {
+        return FALSE;
+    }
+    
+    // window closed, whatever changed meanwhile goes out now (could be nothing if outputs were switched back)
+    notificationPending = FALSE;
+    if (!anyChanged) {
+        return FALSE;
+    }
+    
+    *data++ = notificationSequence++;
+    outputSetToBitmask(&changed, data);
+    notifiedState = state;
+    return TRUE;
+}
+
+void setNotificationWindow(unsigned int window) {
+    if (notificationWindow == NOTIFICATIONS_DISABLED) {
+        // start from the current status, changes while disabled are not notified
+        getOutputState(&notifiedState);
+        notificationPending = FALSE;
+    }
+    notificationWindow = window;
+    queueEepromWord(NOTIFICATION_WINDOW_ADDRESS, window);
+}
@@ -0,0 +1,69 @@
+/* 
+ * Output notifications - opt-in messages sent by CanRelay whenever its outputs change, so that nobody needs to poll the status using GET.
+ * 
+ * All changes within the notification window (since the first change) are coalesced into one notification carrying a sequence number and the mask 
+ * of outputs changed (1 bit per output, the same encoding as the output status in COMPLEX_REPLY). A gap in sequence numbers tells the receiver 
+ * that a notification was missed and the full status should be requested using GET.
+ * 
+ * File:   outputNotifications.h
+ * Author: pojd
+ *
+ * Created on December 12, 2018, 9:22 PM
+ */
+
+#ifndef OUTPUTNOTIFICATIONS_H
+#define	OUTPUTNOTIFICATIONS_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include "utils.h"
+#include "relayOutputs.h"
+#include "relayTimers.h"
+
+// size of the data of one notification - sequence number and the mask of outputs changed
+#define NOTIFICATION_MASK_SIZE 4
+#define NOTIFICATION_SIZE (1 + NOTIFICATION_MASK_SIZE)
+
+// notifications are sent as COMPLEX_REPLY messages with this nodeID offset within the floor (GET replies use the floor itself)
+#define NOTIFICATION_NODEID_OFFSET 1
+
+/**
+ * Notification window in quarters of a second (2 bytes) stored right after output timers
+ */
+#define NOTIFICATION_WINDOW_ADDRESS OUTPUT_TIMERS_END_ADDRESS
+#define NOTIFICATIONS_DISABLED 0
+
+/**
+ * Operations
+ */
+
+/**
+ * Loads the notification window from EEPROM (notifications are disabled by default). Has to be called once outputs are switched as they should be on startup
+ */
+void initNotifications();
+
+/**
+ * Checks whether a notification is to be sent now, i.e. outputs changed and the notification window since the first change passed.
+ * To be called regularly from the main loop
+ * 
+ * @param time current time in quarters of a second
+ * @param data where to write the notification data to (NOTIFICATION_SIZE bytes)
+ * @return TRUE if the notification should be sent (data written), FALSE otherwise
+ */
+boolean nextNotification(unsigned long time, byte* data);
+
+/**
+ * Sets and stores the new notification window
+ * 
+ * @param window window in quarters of a second, NOTIFICATIONS_DISABLED to stop sending notifications
+ */
+void setNotificationWindow(unsigned int window);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* OUTPUTNOTIFICATIONS_H */
+
@@ -0,0 +1,142 @@
+/* 
+ * Output persistence implementation - wear levelled ring of snapshots in EEPROM, written using the DAO queue
+ * 
+ * File:   outputPersistence.c
+ * Author: pojd
+ *
+ * Created on December 6, 2018, 8:52 PM
+ */
+
+#include "outputPersistence.h"
+#include "daoQueue.h"
+
+// position of data in one snapshot
+#define SNAPSHOT_SEQUENCE 0
+#define SNAPSHOT_LATS 1
+#define SNAPSHOT_CHECKSUM 6
+
+/** current persistence delay in quarters of a second */
+unsigned int persistenceDelay = DEFAULT_PERSISTENCE_DELAY;
+
+/** slot and sequence number of the next snapshot to write */
+byte nextSnapshotSlot = 0;
+byte nextSnapshotSequence = 0;
+
+/** status of outputs last seen by the main loop and since when (used to find out whether the status is stable) */
+OutputSet observedState;
+unsigned long observedSince = 0;
+
+/** status of outputs in the latest snapshot */
+OutputSet persistedState;
+
+/*
+ * Private methods
+ */
+
+byte snapshotChecksum(byte* snapshot) {
+    // never written EEPROM (all bits set) or all zeros would not match
+    byte checksum = 0x5A;
+    for (byte i=0; i<SNAPSHOT_CHECKSUM; i++) {
+        checksum += snapshot[i];
+    }
+    return checksum;
+}
+
+boolean readSnapshot(byte slot, byte* snapshot) {
+    readEeprom(OUTPUT_SNAPSHOTS_ADDRESS + slot * OUTPUT_SNAPSHOT_SIZE, snapshot, OUTPUT_SNAPSHOT_SIZE);
+    return (snapshot[SNAPSHOT_CHECKSUM] == snapshotChecksum(snapshot)) ? TRUE : FALSE;
+}
+
+boolean isSameState(OutputSet* state1, OutputSet* state2) {
+    for (byte i=0; i<PORTS_COUNT; i++) {
+        if (state1->masks[i] != state2->masks[i]) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+void writeSnapshot(OutputSet* state) {
+    byte snapshot[OUTPUT_SNAPSHOT_SIZE];
+    snapshot[SNAPSHOT_SEQUENCE] = nextSnapshotSequence;
+    for (byte i=0; i<PORTS_COUNT; i++) {
+        snapshot[SNAPSHOT_LATS + i] = state->masks[i];
+    }
+    snapshot[SNAPSHOT_CHECKSUM] = snapshotChecksum(snapshot);
+    snapshot[SNAPSHOT_CHECKSUM + 1] = 0;
+    
+    // the word with the sequence number goes last, so that a snapshot written only partially (power loss) never looks like the latest one
+    unsigned int address = OUTPUT_SNAPSHOTS_ADDRESS + nextSnapshotSlot * OUTPUT_SNAPSHOT_SIZE;
+    for (byte i=2; i<=OUTPUT_SNAPSHOT_SIZE; i+=2) {
+        byte offset = i % OUTPUT_SNAPSHOT_SIZE;
+        queueEepromWord(address + offset, (snapshot[offset] << 8) | snapshot[offset+1]);
+    }
+    
+    nextSnapshotSlot = (nextSnapshotSlot + 1) % OUTPUT_SNAPSHOTS_COUNT;
+    nextSnapshotSequence++;
+}
+
+/*
+ * API methods
+ */
+
+void restoreOutputs() {
+    byte delay[2];
+    readEeprom(PERSISTENCE_DELAY_ADDRESS, delay, 2);
+    persistenceDelay = (delay[0] << 8) | delay[1];
+    if (persistenceDelay == 0xFFFF) {
+        persistenceDelay = DEFAULT_PERSISTENCE_DELAY; // never set
+    }
+    
+    // the latest snapshot is the valid one not followed by the next sequence number in the next slot (the ring is shorter than the sequence numbers)
+    byte previous[OUTPUT_SNAPSHOT_SIZE], current[OUTPUT_SNAPSHOT_SIZE];
+    boolean previousValid = readSnapshot(0, previous);
+    clearOutputSet(&persistedState);
+    
+    for (byte slot=1; slot<=OUTPUT_SNAPSHOTS_COUNT; slot++) {
+        boolean currentValid = readSnapshot(slot % OUTPUT_SNAPSHOTS_COUNT, current);
+        if (previousValid && (!currentValid || current[SNAPSHOT_SEQUENCE] != (byte)(previous[SNAPSHOT_SEQUENCE] + 1))) {
+            for (byte i=0; i<PORTS_COUNT; i++) {
+                persistedState.masks[i] = previous[SNAPSHOT_LATS + i];
+            }
+            nextSnapshotSlot = slot % OUTPUT_SNAPSHOTS_COUNT;
+            nextSnapshotSequence = previous[SNAPSHOT_SEQUENCE] + 1;
+            break;
+        }
+        
+        for (byte i=0; i<OUTPUT_SNAPSHOT_SIZE; i++) {
+            previous[i] = current[i];
+        }
+        previousValid = currentValid;
+    }
+    
+    // all at once, then read it back (only outputs are restored)
+    restoreOutputState(&persistedState);
+    getOutputState(&persistedState);
+    observedState = persistedState;
+}
+
+void processOutputPersistence(unsigned long time) {
+    if (persistenceDelay == PERSISTENCE_DISABLED) {
+        return;
+    }
+    
+    OutputSet state;
+    getOutputState(&state);
+    if (!isSameState(&state, &observedState)) {
+        // changed again, so start waiting from now
+        observedState = state;
+        observedSince = time;
+        return;
+    }
+    
+    if (!isSameState(&observedState, &persistedState) && (time - observedSince) >= persistenceDelay) {
+        writeSnapshot(&observedState);
+        persistedState = observedState;
+    }
+}
+
+void setPersistenceDelay(unsigned int delay) {
+    persistenceDelay = delay;
+    queueEepromWord(PERSISTENCE_DELAY_ADDRESS, delay);
+}
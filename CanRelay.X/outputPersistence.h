@@ -0,0 +1,73 @@
+/* 
+ * Output persistence keeps the status of all outputs in EEPROM, so that it can be restored after a power loss. 
+ * 
+ * The status is written as a snapshot (sequence number, LAT shadows and a checksum) into a ring of snapshots, each snapshot to the next slot, 
+ * so that the EEPROM wear is spread across the whole ring. A snapshot is only written once the status did not change for the persistence delay,
+ * i.e. any number of changes in a quick sequence end up in a single snapshot. Everything is done from the main loop, switching outputs itself is not
+ * affected at all.
+ * 
+ * File:   outputPersistence.h
+ * Author: pojd
+ *
+ * Created on December 6, 2018, 8:34 PM
+ */
+
+#ifndef OUTPUTPERSISTENCE_H
+#define	OUTPUTPERSISTENCE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include "utils.h"
+#include "relayOutputs.h"
+#include "relayMappings.h"
+
+/**
+ * Ring of snapshots right after the mapping image header. Each snapshot has: sequence number, 5 LAT shadows, checksum and 1 unused byte
+ */
+#define OUTPUT_SNAPSHOT_SIZE 8
+#define OUTPUT_SNAPSHOTS_COUNT 32
+#define OUTPUT_SNAPSHOTS_ADDRESS (MAPPING_IMAGE_ADDRESS + MAPPING_IMAGE_HEADER_SIZE)
+
+/**
+ * Persistence delay in quarters of a second (2 bytes) right after the ring
+ */
+#define PERSISTENCE_DELAY_ADDRESS (OUTPUT_SNAPSHOTS_ADDRESS + OUTPUT_SNAPSHOT_SIZE * OUTPUT_SNAPSHOTS_COUNT)
+#define DEFAULT_PERSISTENCE_DELAY 20 // 5 seconds
+#define PERSISTENCE_DISABLED 0
+
+/**
+ * First EEPROM address not used by output persistence
+ */
+#define OUTPUT_PERSISTENCE_END_ADDRESS (PERSISTENCE_DELAY_ADDRESS + 2)
+
+/**
+ * Operations
+ */
+
+/**
+ * Finds the latest snapshot in EEPROM and switches the outputs as per that snapshot (all at once). Outputs have to be initialized first (see initOutputs)
+ */
+void restoreOutputs();
+
+/**
+ * Writes a new snapshot if the status of outputs changed and then did not change for the persistence delay. To be called regularly from the main loop
+ * 
+ * @param time current time in quarters of a second
+ */
+void processOutputPersistence(unsigned long time);
+
+/**
+ * Sets and stores the new persistence delay
+ * 
+ * @param delay new delay in quarters of a second, PERSISTENCE_DISABLED to stop writing any snapshots (the last one is restored still)
+ */
+void setPersistenceDelay(unsigned int delay);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* OUTPUTPERSISTENCE_H */
+
@@ -0,0 +1,123 @@
+/* 
+ * Relay filters implementation
+ * 
+ * File:   relayFilters.c
+ * Author: pojd
+ *
+ * Created on December 14, 2018, 8:24 PM
+ */
+
+#include "relayFilters.h"
+
+// nodeIDs within 1 floor (the first bit of nodeID is the floor)
+#define FLOOR_NODE_IDS_COUNT 128
+#define FLOOR_NODE_ID_BITS 7
+
+/** filters to be used for NORMAL messages */
+const byte normalFilters[NORMAL_FILTERS_COUNT] = { 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 };
+
+/** nodeIDs (without the floor bit) to accept, 1 bit per nodeID */
+byte acceptedNodeIDs[FLOOR_NODE_IDS_COUNT / 8];
+
+/*
+ * Private methods
+ */
+
+void acceptNodeID(byte nodeID) {
+    nodeID &= FLOOR_NODE_IDS_COUNT-1;
+    acceptedNodeIDs[nodeID >> 3] |= 1 << (nodeID & 0b111);
+}
+
+/**
+ * Counts the nodeIDs accepted within the group of nodeIDs (group of nodeIDs having all but lowest bits the same)
+ */
+byte countGroupNodeIDs(byte group, byte lowBits) {
+    byte count = 0;
+    byte first = group << lowBits;
+    byte last = first + (1 << lowBits);
+    for (byte nodeID = first; nodeID < last; nodeID++) {
+        if (acceptedNodeIDs[nodeID >> 3] & (1 << (nodeID & 0b111))) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Counts the groups with at least 1 accepted nodeID when leaving out the lowest bits
+ */
+byte countGroups(byte lowBits) {
+    byte groups = 0;
+    for (byte group = 0; group < (FLOOR_NODE_IDS_COUNT >> lowBits); group++) {
+        if (countGroupNodeIDs(group, lowBits)) {
+            groups++;
+        }
+    }
+    return groups;
+}
+
+/*
+ * API methods
+ */
+
+void setupNormalFilters(byte floor) {
+    for (byte i=0; i<sizeof(acceptedNodeIDs); i++) {
+        acceptedNodeIDs[i] = 0;
+    }
+    
+    // floor itself means all outputs
+    acceptNodeID(floor);
+    
+    // mapped nodeIDs of this floor only (others would never get here anyway)
+    Mappings* mappings = getRuntimeMappings();
+    for (byte i=0; i<mappings->size; i++) {
+        byte nodeID = mappings->array[i].nodeID;
+        if (nodeID != UNMMAPED_NODEID && (nodeID & FLOOR_NODE_IDS_COUNT) == (floor & FLOOR_NODE_IDS_COUNT)) {
+            // and the nodeIDs of batched messages this nodeID could be part of (never below the floor)
+            for (byte j=0; j<BATCH_NODE_IDS && j < (nodeID & (FLOOR_NODE_IDS_COUNT-1)); j++) {
+                acceptNodeID(nodeID - j);
+            }
+        }
+    }
+    
+    for (byte i=0; i<SCENES_COUNT; i++) {
+        if (isSceneUsed(i)) {
+            acceptNodeID(SCENE_NODEID_OFFSET + i);
+        }
+    }
+    
+    // leave out as few lowest bits as possible to fit into the filters, with all bits left out there is always just 1 group
+    byte lowBits = 0;
+    while (lowBits < FLOOR_NODE_ID_BITS && countGroups(lowBits) > NORMAL_FILTERS_COUNT) {
+        lowBits++;
+    }
+    setupReceiveFilter15Mask(STRICT_ID_MASK & ~((1 << lowBits) - 1));
+    
+    CanHeader header;
+    header.messageType = NORMAL;
+    byte filter = 0;
+    for (byte group = 0; group < (FLOOR_NODE_IDS_COUNT >> lowBits); group++) {
+        byte count = countGroupNodeIDs(group, lowBits);
+        if (!count) {
+            continue;
+        }
+        
+        byte nodeID = (floor & FLOOR_NODE_IDS_COUNT) | (group << lowBits);
+        if (count == 1) {
+            // find the only nodeID to use the strict mask
+            while (!(acceptedNodeIDs[(nodeID & (FLOOR_NODE_IDS_COUNT-1)) >> 3] & (1 << (nodeID & 0b111)))) {
+                nodeID++;
+            }
+            header.nodeID = nodeID;
+            setupReceiveFilter(normalFilters[filter++], 1, &header);
+        } else {
+            header.nodeID = nodeID;
+            setupReceiveFilter(normalFilters[filter++], FILTER_15_MASK, &header);
+        }
+    }
+    
+    // and disable the rest of the filters
+    for (; filter < NORMAL_FILTERS_COUNT; filter++) {
+        disableReceiveFilter(normalFilters[filter]);
+    }
+}
@@ -0,0 +1,53 @@
+/* 
+ * Relay filters generate the ECAN acceptance filters for NORMAL messages from the current mappings, so that messages of nodeIDs not mapped
+ * are rejected by the CAN module itself and never reach the CPU.
+ * 
+ * The nodeIDs to accept are the floor itself, all mapped nodeIDs and nodeIDs of all used scenes. Batched NORMAL messages of CanSwitches only carry
+ * the lowest nodeID changed (the other nodeIDs are in the data), so up to BATCH_NODE_IDS-1 nodeIDs below each mapped nodeID are accepted too.
+ * If there are more of them than filters available, 
+ * nodeIDs are grouped by leaving out the lowest bits (as few as possible) using filter 15 as a group mask. A group with only 1 nodeID still uses 
+ * a strict filter. In the worst case (all bits left out) the whole floor is accepted, i.e. the same as with no generated filters.
+ * 
+ * File:   relayFilters.h
+ * Author: pojd
+ *
+ * Created on December 14, 2018, 8:10 PM
+ */
+
+#ifndef RELAYFILTERS_H
+#define	RELAYFILTERS_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include "utils.h"
+#include "canReceive.h"
+#include "relayMappings.h"
+#include "relayScenes.h"
+
+// number of filters available for NORMAL messages (all but 5 filters used for other message types and filter 15 used as a mask)
+#define NORMAL_FILTERS_COUNT 11
+// filter used for network commands
+#define NETWORK_FILTER 14
+// nodeIDs covered by 1 batched NORMAL message of a CanSwitch - the nodeID of the message and the nodeIDs of the mask in the data following it
+#define BATCH_NODE_IDS 8
+
+/**
+ * Operations
+ */
+
+/**
+ * Sets up all filters for NORMAL messages using masks 1 (has to be the strict mask) and filter 15 as a mask. 
+ * Has to be called in CAN CONFIG mode, mappings and scenes have to be initialized first
+ * 
+ * @param floor floor of this relay
+ */
+void setupNormalFilters(byte floor);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* RELAYFILTERS_H */
+
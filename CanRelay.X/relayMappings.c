@@ -10,55 +10,20 @@
 
 #include "canSwitches.h"
 #include "dao.h"
+#include "daoQueue.h"
 #include "relayMappings.h"
 
-/** 
- * Static output array to list all port and bit shifts.
- * 
- * Each line/array item here matches 1 label in output on relay silkscreen. I.e. line 1 matches label 1 on ground floor, line 2 label 2, etc. 
- * Strictly speaking when accessing, for output x, index x-1 should be used since as usual, arrays are indexed from 0
- * 
- * It should match can-pcb schematic of pin outputs on the chip. See https://github.com/PoJD/can-pcb/tree/master/CanRelay for details
- */
-Output outputs[OUTPUTS_COUNT] = { 
-    { &PORTD, 7 }, // RD7  O1
-    { &PORTB, 0 }, // RB0  O2
-    { &PORTD, 6 }, // RD6  O3
-    { &PORTB, 1 }, // RB1  O4
-    { &PORTD, 5 }, // RD5  O5
-    { &PORTB, 4 }, // RB4  O6
-    { &PORTD, 4 }, // RD4  O7
-    { &PORTB, 5 }, // RB5  O8
-    { &PORTC, 7 }, // RC7  O9
-    { &PORTB, 6 }, // RB6  O10
-    { &PORTC, 6 }, // RC6  O11
-    { &PORTB, 7 }, // RB7  O12
-    { &PORTC, 5 }, // RC5  O13
-    { &PORTA, 0 }, // RA0  O14
-    { &PORTC, 4 }, // RC4  O15
-    { &PORTA, 1 }, // RA1  O16
-    { &PORTD, 3 }, // RD3  O17
-    { &PORTA, 2 }, // RA2  O18
-    { &PORTD, 2 }, // RD2  O19
-    { &PORTA, 3 }, // RA3  O20
-    { &PORTD, 1 }, // RD1  O21
-    { &PORTA, 5 }, // RA5  O22
-    { &PORTD, 0 }, // RD0  O23
-    { &PORTE, 0 }, // RE0  O24
-    { &PORTC, 3 }, // RC3  O25
-    { &PORTE, 1 }, // RE1  O26
-    { &PORTC, 2 }, // RC2  O27
-    { &PORTE, 2 }, // RE2  O28
-    { &PORTC, 1 }, // RC1  O29
-    { &PORTC, 0 }, // RC0  O30
-};
-
 /**
  * Here in the internal size we simply keep the maximum number of output used so far by any mapping (1 based)
  * This way we keep track of all outputs used and it is assumed that all smaller numbered outputs are used as well (to avoid extra logic looping through all used all the time when matching)
  * 0 on startup and gets updated on initial load or during runtime too.
  */
-UsedOutputs usedOutputs = { outputs, 0 };
+byte usedOutputsSize = 0;
+
+/**
+ * All used outputs (as per the size above) as an output set, so that operations on all used outputs are done in one pass
+ */
+OutputSet usedOutputSet;
 
 /**
  * Dynamic "map" of all mappings from nodeID to outputs. Initially loaded using DAO, at runtime can be changed
@@ -66,40 +31,56 @@ UsedOutputs usedOutputs = { outputs, 0 };
 Mapping mappingsArray[MAX_MAPPING_SIZE];
 Mappings mappings = { mappingsArray, 0 };
 
+/**
+ * Precomputed output sets - one for each distinct mapped nodeID. Each set contains all outputs the nodeID is mapped to as per port masks,
+ * so that one nodeID can switch multiple outputs in a single pass.
+ */
+OutputSet outputSets[MAX_OUTPUT_SETS];
+byte outputSetsSize = 0;
+
+/**
+ * Direct lookup table from nodeID to output set (index into outputSets + 1, 0 = nodeID not mapped). Built from the mappings above, so that
+ * resolving an incoming nodeID costs just one indexed load regardless of the number of mappings.
+ */
+byte nodeIDOutputSets[NODE_IDS_COUNT];
+
 /** 
- * Simple array where each index is reserved for output and value is the last time a non-GET operation was invoked for that output.
- * This way we implement sort of a switch debouncer inside CanRelay and protect against sporadic CAN messages from CanSwitches.
+ * Per port masks of outputs a non-GET operation was invoked for in the current quarter of a second (recentAccessMasks, time kept in recentAccessTime)
+ * and the quarter before that (previousAccessMasks). This way we implement sort of a switch debouncer inside CanRelay and protect against sporadic CAN messages from CanSwitches.
  * It is more generic - i.e. any operation other than GET for a given output is always tracked. So even if someone tries to click very 
  * quickly perhaps via Apple HomeKit, it would be ignored if done too quickly (faster than 250-500ms).
  * We do not use mappings for this in order to properly "protect" outputs directly since multiple nodeIDs in mapping can be mapped to 1 output
  * 
  * The actual time stored is in quarters per second and no need to worry about overflow - it is about 34 years and unlikely 
  * there would be any power outage within 34 years :)
- * 
- * Only real used outputs are actually set and used, the rest is ignored.
  */
-unsigned long outputsLastAccessTime[OUTPUTS_COUNT];
+byte recentAccessMasks[PORTS_COUNT];
+byte previousAccessMasks[PORTS_COUNT];
+unsigned long recentAccessTime = 0;
 
-/*
- * Private methods
+/** 
+ * Output set returned by nodeIDToOutputs - the mapped output set with any outputs accessed too recently filtered out
  */
+OutputSet accessibleOutputs;
 
-void setLastAccessTime(byte outputNumber, unsigned long time) {
-    outputsLastAccessTime[outputNumber-1] = time;
-}
+/**
+ * CRC-16-CCITT lookup table for 4 bits at a time (to keep it small)
+ */
+const unsigned int crcTable[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
 
-unsigned long getLastAccessTime(byte outputNumber) {
-    return outputsLastAccessTime[outputNumber-1];
-}
+/*
+ * Private methods
+ */
 
 void updateUsedOutputs(byte outputNumber) {
     // outputNumber is 1 based, so we can take directly as the size
-    if (outputNumber > usedOutputs.size) {
-        usedOutputs.size = outputNumber;
+    // the outputs added are always those up to the new size (see above)
+    for (; usedOutputsSize < outputNumber; usedOutputsSize++) {
+        addOutputToSet(&usedOutputSet, usedOutputsSize+1);
     }
-    // and also update last time for this output to be 0 - this is first time we are enabling it (either on startup or at runtime), so first invocation will reset this time 
-    // to the real time and protection against sporadic access would kick in on subsequent operations
-    setLastAccessTime(outputNumber, 0);    
 }
 
 void updateMappingCache(byte mappingNumber, byte nodeID, byte outputNumber) {
@@ -111,23 +92,130 @@ void updateMappingCache(byte mappingNumber, byte nodeID, byte outputNumber) {
     }
 }
 
+void rebuildNodeIDLookup() {
+    for (int i=0; i<NODE_IDS_COUNT; i++) {
+        nodeIDOutputSets[i] = 0;
+    }
+    outputSetsSize = 0;
+    
+    Mapping *m = mappings.array;
+    Mapping *mEnd = mappings.array + mappings.size;
+    
+    for (; m < mEnd; m++) {
+        // unmapped nodeID is never to be found
+        if (m->nodeID == UNMMAPED_NODEID) {
+            continue;
+        }
+        
+        // first time we see this nodeID, so reserve a new output set for it (or ignore it if we ran out of sets)
+        if (!nodeIDOutputSets[m->nodeID]) {
+            if (outputSetsSize == MAX_OUTPUT_SETS) {
+                continue;
+            }
+            clearOutputSet(&outputSets[outputSetsSize++]);
+            nodeIDOutputSets[m->nodeID] = outputSetsSize;
+        }
+        
+        // and now add the output of this mapping to the set of that nodeID
+        addOutputToSet(&outputSets[nodeIDOutputSets[m->nodeID]-1], m->outputNumber);
+    }
+}
+
+unsigned int updateCrc(unsigned int crc, byte value) {
+    crc = (crc << 4) ^ crcTable[((crc >> 12) ^ (value >> 4)) & 0x0F];
+    crc = (crc << 4) ^ crcTable[((crc >> 12) ^ value) & 0x0F];
+    return crc;
+}
 
-/*
- * API methods
+unsigned int mappingsCrc() {
+    unsigned int crc = 0xFFFF; // CCITT initial value
+    byte* data = (byte*) mappings.array;
+    byte* dataEnd = (byte*) (mappings.array + mappings.size);
+    
+    for (; data < dataEnd; data++) {
+        crc = updateCrc(crc, *data);
+    }
+    return crc;
+}
+
+/**
+ * Stores the mapping into DAO, written in the background from the main loop (see daoQueue.h)
  */
+void queueMapping(byte mappingNumber, byte nodeID, byte outputNumber) {
+    DataItem dataItem;
 
-UsedOutputs* getUsedOutputs() {
-    return &usedOutputs;
-}
+    // mappingNumber shall be a sequence of numbers 1..MAX, so use it as the bucket number to store it into using the DAO
+    dataItem.bucket = mappingNumber-1 + MAPPING_START_DAO_BUCKET;
+    // value would be nodeID the higher 8 bits and outputNumber the lower 8 bits
+    dataItem.value = (nodeID << 8) + outputNumber;
 
-Mappings* getRuntimeMappings() {
-    return &mappings;
+    queueDataItem(&dataItem);
 }
 
-void initMapping () {
+void resetMappings() {
     mappings.size = 0;
-    usedOutputs.size = 0;
+    usedOutputsSize = 0;
+    clearOutputSet(&usedOutputSet);
+}
+
+/**
+ * Puts the mapping as read from DAO into runtime mappings
+ */
+void loadMapping(byte mappingNumber, byte nodeID, byte outputNumber) {
+    // just to be super sure somehow we did not get invalid outputIndex into DAO, rather check output index value read
+    // since through the API method calls we have this covered (see updateMapping method below)
+    // this time we do not break the loop, just continue on to the next one and set some dummy value for nodeID to make sure it is never triggered
+    if (outputNumber<=0 || outputNumber>OUTPUTS_COUNT) {
+        nodeID = UNMMAPED_NODEID; // should never be used as real mapping
+        outputNumber = OUTPUTS_COUNT; // just to make sure we have valid outputs at least in the mappings
+        // and store it like that, so that DAO holds the same as the runtime mappings and the CRC of the mapping image matches on next start
+        queueMapping(mappingNumber, nodeID, outputNumber);
+    } else {
+        // for valid mappings only, update the used outputs...
+        updateUsedOutputs(outputNumber);
+    }
+    // we always store the number in DAO from 1 to also allow CONFIG messages to use real numbers from 1 matching the silkscreen of the PCB
+    updateMappingCache(mappingNumber, nodeID, outputNumber);
+}
+
+/**
+ * Loads all mappings in one sequential read as per the mapping image header
+ * 
+ * @return TRUE if the mappings read match the CRC in the header, FALSE otherwise (the runtime mappings need to be reset then)
+ */
+boolean loadMappingImage() {
+    byte header[MAPPING_IMAGE_HEADER_SIZE];
+    readEeprom(MAPPING_IMAGE_ADDRESS, header, MAPPING_IMAGE_HEADER_SIZE);
+    unsigned int size = (header[0] << 8) | header[1];
+    unsigned int crc = (header[2] << 8) | header[3];
+    
+    // never written header would have all bits set
+    if (size > MAX_MAPPING_SIZE) {
+        return FALSE;
+    }
     
+    // the bucket right after the mappings has to be unset, otherwise someone stored mappings without updating the header
+    if (size < MAX_MAPPING_SIZE) {
+        DataItem dataItem = dao_loadDataItem(size + MAPPING_START_DAO_BUCKET);
+        if (dao_isValid(&dataItem)) {
+            return FALSE;
+        }
+    }
+    
+    // DAO stores nodeID the higher 8 bits and output number the lower 8 bits, i.e. the same as the runtime mappings, so read directly into them
+    readEeprom(MAPPING_START_DAO_BUCKET * DAO_BUCKET_SIZE, (byte*) mappings.array, size * sizeof(Mapping));
+    for (int mappingNumber = 1; mappingNumber <= size; mappingNumber++) {
+        Mapping* mapping = &mappings.array[mappingNumber-1];
+        loadMapping(mappingNumber, mapping->nodeID, mapping->outputNumber);
+    }
+    
+    return (mappingsCrc() == crc) ? TRUE : FALSE;
+}
+
+/**
+ * Loads all mappings one by one using the DAO, stops on the first bucket not set
+ */
+void scanMappings() {
     // loop through all potential mappings now, skip when finding first not set
     // i.e. therefore if someone attempts to update mapping that has a gap before it (previous mapping not set), it would be ignored
     int bucket = 1;
@@ -138,104 +226,149 @@ void initMapping () {
         }
         
         // higher 8 bits is nodeID, lower 8 bits is output number starting from 1
-        // just to be super sure somehow we did not get invalid outputIndex into DAO, rather check output index value read
-        // since through the API method calls we have this covered (see updateMapping method below)
-        // this time we do not break the loop, just continue on to the next one and set some dummy value for nodeID to make sure it is never triggered
-
-        byte nodeID = (dataItem.value >> 8) & MAX_8_BITS;
-        byte outputNumber = dataItem.value & MAX_8_BITS;
-        if (outputNumber<=0 || outputNumber>OUTPUTS_COUNT) {
-            nodeID = UNMMAPED_NODEID; // should never be used as real mapping
-            outputNumber = OUTPUTS_COUNT; // just to make sure we have valid outputs at least in the mappings
-        } else {
-            // for valid mappings only, update the used outputs...
-            updateUsedOutputs(outputNumber);
-        }
-        // we always store the number in DAO from 1 to also allow CONFIG messages to use real numbers from 1 matching the silkscreen of the PCB
-        updateMappingCache(bucket, nodeID, outputNumber);
+        loadMapping(bucket, (dataItem.value >> 8) & MAX_8_BITS, dataItem.value & MAX_8_BITS);
     }
 }
 
-Output* nodeIDToOutput (byte nodeID, unsigned long time) {
-    if (nodeID==UNMMAPED_NODEID) {
-        return NULL;
-    }    
-    
-    Mapping *m = mappings.array;
-    Mapping *mEnd = mappings.array + mappings.size;
+void saveMappingImageHeader() {
+    // written in the background after any mappings queued already
+    queueEepromWord(MAPPING_IMAGE_ADDRESS, mappings.size);
+    queueEepromWord(MAPPING_IMAGE_ADDRESS + 2, mappingsCrc());
+}
+
+/**
+ * Sets the bits of outputs starting from the first output in passed (count has to be divisible by 8), outputs not used are set as blank
+ */
+void retrieveOutputBits(unsigned int firstOutputNumber, byte count, byte* data) {
+    for (byte i=0; i<count/8; i++) {
+        data[i] = 0;
+    }
     
-    for (; m < mEnd; m++) {
-        if (m->nodeID == nodeID) {
-            // now check the last time this output was used and if interval not passed yet, return NULL too
-            // we count in quarters per second, so make sure at least 1 quarter already passed
-            if (time > getLastAccessTime(m->outputNumber) + 1) {
-                // if all OK, just update the last access time and return the respective output
-                setLastAccessTime(m->outputNumber, time);
-                return &outputs[m->outputNumber-1];
-            } else {
-                return NULL;
-            }
+    for (byte i=0; i<count; i++) {
+        unsigned int outputNumber = firstOutputNumber + i;
+        if (outputNumber > usedOutputsSize) {
+            break;
         }
+        // set the bit starting from the largest bit of each byte
+        if (isOutputOn(outputNumber)) {
+            data[i/8] |= 1 << (7 - i%8);
+        }
+    }
+}
+
+/**
+ * Moves the access masks to the time passed in, i.e. the recent masks become the previous masks if we moved just by 1 quarter or all masks are cleared if we moved even more
+ */
+void updateAccessMasks(unsigned long time) {
+    if (time == recentAccessTime) {
+        return;
     }
     
-    return NULL; // should never happen, means we got a nodeID we do not understand
+    for (byte i=0; i<PORTS_COUNT; i++) {
+        previousAccessMasks[i] = (time == recentAccessTime + 1) ? recentAccessMasks[i] : 0;
+        recentAccessMasks[i] = 0;
+    }
+    recentAccessTime = time;
 }
 
-void retrieveOutputStatus(byte* data) {
-    byte currentBitCount = 0, currentByte = 0;
+/*
+ * API methods
+ */
+
+OutputSet* getUsedOutputSet() {
+    return &usedOutputSet;
+}
+
+Mappings* getRuntimeMappings() {
+    return &mappings;
+}
+
+void initMapping () {
+    resetMappings();
     
-    Output *o = usedOutputs.array;
-    Output *oEnd = usedOutputs.array + usedOutputs.size;
+    // fast path first, if the image does not match, then fall back to checking the DAO buckets one by one
+    if (!loadMappingImage()) {
+        resetMappings();
+        scanMappings();
+    }
     
-    // first byte is always the size of used outputs
-    *data++ = usedOutputs.size;
+    rebuildNodeIDLookup();
+    // make sure the next start can use the image (nothing is written if the header did not change)
+    saveMappingImageHeader();
+}
 
-    // regardless of how many outputs we actually use, always set next 4 bytes...
-    for (int i=0; i<5; i++) {
-        data[i] = 0;
+OutputSet* nodeIDToOutputs (byte nodeID, unsigned long time) {
+    byte outputSetIndex = nodeIDOutputSets[nodeID];
+    if (!outputSetIndex) {
+        return NULL; // means we got a nodeID we do not understand (or unmapped nodeID)
     }
     
-    for (; o < oEnd; o++) {
-        // first find out whether the respective bit in the respective port is set, 
-        // then shift it to set the current bit in the current byte starting from the largest bit
-        currentByte += ( (*o->port >> o->portBit) & 1 ) << (7-currentBitCount);
-        
-        if (currentBitCount++ == 7) {
-            // ok, now we have the full byte to set, so reset and set the output data byte
-            *data++ = currentByte;
-            currentByte = 0;
-            currentBitCount = 0;
-        }
+    // now filter out outputs accessed in this or previous quarter of a second, i.e. make sure at least 1 quarter already passed since last access
+    updateAccessMasks(time);
+    OutputSet* outputSet = &outputSets[outputSetIndex-1];
+    byte accessible = 0;
+    
+    for (byte i=0; i<PORTS_COUNT; i++) {
+        byte mask = outputSet->masks[i] & ~(recentAccessMasks[i] | previousAccessMasks[i]);
+        accessible |= mask;
+        accessibleOutputs.masks[i] = mask;
+        // and mark the outputs as accessed now
+        recentAccessMasks[i] |= mask;
     }
     
-    // if something was already added up to the current byte (i.e. we could be in the middle of it), then add it to data too
-    if (currentByte) {
-        *data++ = currentByte;        
+    return accessible ? &accessibleOutputs : NULL;
+}
+
+void retrieveOutputStatus(byte* data) {
+    // first byte is always the size of used outputs
+    *data++ = usedOutputsSize;
+    // and then always next 4 bytes
+    retrieveOutputBits(1, STATUS_OUTPUTS, data);
+}
+
+void retrieveOutputStatusPage(byte page, byte* data) {
+    *data++ = usedOutputsSize;
+    *data++ = page;
+    // and then always next 3 bytes, the page is never beyond the byte range of outputs
+    retrieveOutputBits(page * STATUS_PAGE_OUTPUTS + 1, STATUS_PAGE_OUTPUTS, data);
+}
+
+byte getOutputStatusPages() {
+    if (usedOutputsSize <= STATUS_OUTPUTS) {
+        return 0;
     }
+    return (usedOutputsSize + STATUS_PAGE_OUTPUTS - 1) / STATUS_PAGE_OUTPUTS;
 }
 
-void updateMapping (byte mappingNumber, byte nodeID, byte outputNumber) {
+void stageMapping (byte mappingNumber, byte nodeID, byte outputNumber) {
     // majority of checks done by the datatypes themselves, so only check the output number is in range 1.OUTPUTS_COUNT as that is real mapping size of relay
     // and also check that mapping number is in range 1 .. max number of mappings
     // we do not care if we received UNMMAPED_NODEID nodeID here since that could also potentially be stored already in DAO by someone, so we just need to check
     // that in the nodeIDToOutput method
     
+    if (mappingNumber<=0 || mappingNumber>MAX_MAPPING_SIZE) {
+        return;
+    }
+    
     // also allow MAX_8_BITS outputnumber and nodeID that would effectively "erase" that mapping in DAO (use the same as default values)
-    if (mappingNumber>0 && ( (outputNumber>0 && outputNumber<=OUTPUTS_COUNT) || (outputNumber==MAX_8_BITS && nodeID == MAX_8_BITS) )) {
-        DataItem dataItem;
-
-        // mappingNumber shall be a sequence of numbers 1..MAX, so use it as the bucket number to store it into using the DAO
-        dataItem.bucket = mappingNumber-1 + MAPPING_START_DAO_BUCKET;
-        // value would be nodeID the higher 8 bits and outputNumber the lower 8 bits
-        dataItem.value = (nodeID << 8) + outputNumber;
-
-        // store new value into DAO 
-        dao_saveDataItem(&dataItem);
+    if (( (outputNumber>0 && outputNumber<=OUTPUTS_COUNT) || (outputNumber==MAX_8_BITS && nodeID == MAX_8_BITS) )) {
+        queueMapping(mappingNumber, nodeID, outputNumber);
     }
     
     if (outputNumber>0 && outputNumber<=OUTPUTS_COUNT) {
         // now also update runtime status of used outputs and mappings
+        // the nodeID lookup is only rebuilt on commit
         updateMappingCache(mappingNumber, nodeID, outputNumber);
         updateUsedOutputs(outputNumber);
     }
 }
+
+void commitMappings() {
+    rebuildNodeIDLookup();
+    saveMappingImageHeader();
+}
+
+void updateMapping (byte mappingNumber, byte nodeID, byte outputNumber) {
+    stageMapping(mappingNumber, nodeID, outputNumber);
+    commitMappings();
+}
@@ -17,35 +17,14 @@ extern "C" {
 #include <xc.h>
 #include "utils.h"
 #include "canSwitches.h"
-
-/**
- * Output structure represent the pair of reference to port and bit to change
- * This is a static array inside the firmware to know how to translate from output numbers on the silk screen to individual port bits.
- * 
- * The same for each relay
- */
-typedef struct {
-    volatile byte* port; // reference to one of the port registers of the chip (e.g. PORTA, PORTB, etc)
-    byte portBit; // actual bit that is to be set/read in this map
-} Output;
-
-/**
- * UsedOutputs is a very very simple sort of iterator, really just a pointer with the size to allow external world loop through the used outputs of this CanRelay
- */
-typedef struct {
-    Output* array;
-    byte size;
-} UsedOutputs;
-
-// how many outputs do physically exist on this CanRelay board?
-#define OUTPUTS_COUNT 30
-
+#include "relayOutputs.h"
+#include "daoQueue.h"
 
 /**
  * Mapping from nodeID -> output, i.e. for a given nodeID it would keep a number of the output to know how to "turn it on or off"
  * This "map" is dynamic, stored in DAO and can be changed dynamically at runtime, e.g. by sending CAN CONFIG messages to the CanRelay.
  * 
- * It is not really a real map, merely an array, i.e. it allows dupes too
+ * It is not really a real map, merely an array, i.e. it allows dupes too. Mapping the same nodeID to more outputs makes that nodeID switch all of them
  * 
  * Therefore this would be different for different floors
  */
@@ -64,9 +43,23 @@ typedef struct {
 
 
 // max size of the dynamic mappings. Use max byte size for this since. We also limit this by the CONFIG data schema, where mapping number is just 1 byte 
-#define MAX_MAPPING_SIZE MAX_8_BITS
+// the last DAO bucket is reserved for the bit rate (see canNetwork.h), so one less
+#define MAX_MAPPING_SIZE (MAX_8_BITS - 1)
 #define MAPPING_START_DAO_BUCKET 1 // 0 is reserved for floor, so we start from 1
 #define UNMMAPED_NODEID MAX_8_BITS // unmapped can ID in the mapping to use as a marker for invalid mapping
+#define NODE_IDS_COUNT 256 // all possible nodeIDs (8 bits), size of the nodeID lookup table
+#define MAX_OUTPUT_SETS 128 // max number of distinct nodeIDs mapped (7 bits of nodeID are left for 1 floor)
+
+// outputs covered by the single status message and by one page of the paged status
+#define STATUS_OUTPUTS 32
+#define STATUS_PAGE_OUTPUTS 24
+
+/**
+ * Header of the compact mapping image, stored right after the DAO buckets: number of mappings (2 bytes) and CRC of all mappings (2 bytes).
+ * The mappings themselves are the DAO buckets starting from MAPPING_START_DAO_BUCKET, so that they can be read in one sequential read on startup
+ */
+#define MAPPING_IMAGE_ADDRESS EEPROM_FREE_ADDRESS
+#define MAPPING_IMAGE_HEADER_SIZE 4
 
 /**
  * Operations
@@ -74,40 +67,65 @@ typedef struct {
 
 /**
  * Initialize mapping using the DAO. This method has to be called in order for the other methods in this header file to work properly!
+ * Outputs have to be initialized first (see initOutputs)
+ * 
+ * Mappings are read in one go using the mapping image header, only if its CRC does not match, all DAO buckets are checked one by one instead
  */
 void initMapping();
 
 /**
- * For a given nodeID, return a reference to output (port and bit to change). Note that multiple nodeIDs can map to the same port and bit,
+ * For a given nodeID, return a reference to all outputs (port masks) to change. Note that multiple nodeIDs can map to the same port and bit,
  * i.e. we can have more light switches connected to one canSwitch that end up switching on the same light even though they are physically
  * connected to different input pins on CanSwitch and thus sending different nodeIDs over the wire. It just gives enough flexibility
  * routing the wires in the walls so that hopefully no need to reuse the very same ware among more wall switches.
+ * And the other way round, one nodeID can be mapped to more outputs, so that one wall switch can switch on more light circuits at once.
+ * 
+ * The lookup itself is constant time (direct table indexed by nodeID), so does not depend on the number of mappings set.
  * 
  * @param nodeID the nodeID received on the wire
  * @param time actual time in quarters per second as measured by the caller. This method internally checks whether the internally stored time
- * of last access to the found output (if found) is smaller than the parameter, i.e. effectively checking if at least 250ms already passed. The actual
- * time passed depends on the actual time this method is invoked, but should be in range 250-500ms as a result.
- * @return Output to use to switch on the respective output or NULL if no such mapping found or this method was called too soon after last invocation for the underlying output
+ * of last access to the found outputs (if found) is smaller than the parameter, i.e. effectively checking if at least 250ms already passed. The actual
+ * time passed depends on the actual time this method is invoked, but should be in range 250-500ms as a result. Outputs accessed too recently are left out.
+ * @return OutputSet to use to switch the respective outputs or NULL if no such mapping found or this method was called too soon after last invocation for all the underlying outputs.
+ * The returned set is only valid till the next call of this method
  */
-Output* nodeIDToOutput (byte nodeID, unsigned long time);
+OutputSet* nodeIDToOutputs (byte nodeID, unsigned long time);
 
 /**
  * Updates the in passed array of byte data with current status of output ports. First byte is always the active switches count. 
- * Remaining 4 bytes are either filled in with real outputs or set as blank depending on the number of outputs
+ * Remaining 4 bytes are either filled in with real outputs or set as blank depending on the number of outputs.
+ * Only covers up to STATUS_OUTPUTS outputs, see retrieveOutputStatusPage for more
  * 
  * @param data data to get populated by this method, always sets 5 bytes
  */
 void retrieveOutputStatus (byte* data);
 
 /**
- * Get UsedOutputs structure so that the caller can iterate through all of them and perform actions against them.
- * Mind that this call returns all outputs irrespective when they were last access. So unlike nodeIDToOutput method, 
+ * Updates the in passed array of byte data with one page of the current status of output ports. First byte is always the active switches count,
+ * second byte is the page, next 3 bytes are outputs of that page (STATUS_PAGE_OUTPUTS outputs starting from output page*STATUS_PAGE_OUTPUTS + 1),
+ * set as blank for outputs not used. The last 3 bytes are left for the same status as in the single message (error counts and firmware version)
+ * 
+ * @param page page of the status
+ * @param data data to get populated by this method, always sets 5 bytes
+ */
+void retrieveOutputStatusPage (byte page, byte* data);
+
+/**
+ * Gets the number of pages needed for the status of all used outputs
+ * 
+ * @return number of pages, 0 if the status of all used outputs fits into retrieveOutputStatus
+ */
+byte getOutputStatusPages ();
+
+/**
+ * Get all used outputs as an output set so that the caller can perform operations against all of them at once.
+ * Mind that this call returns all outputs irrespective when they were last access. So unlike nodeIDToOutputs method, 
  * this method provides no protection from sporadic or very fast calls of operations on the outputs, so the caller
  * needs to assure this is not invoked far too often to cause some fast blinks in the outputs
  * 
- * @return reference to the used outputs (only registered outputs in there)
+ * @return reference to the used outputs set (only registered outputs in there)
  */
-UsedOutputs* getUsedOutputs();
+OutputSet* getUsedOutputSet();
 
 /**
  * Gets the mappings used at runtime by this CanRelay
@@ -117,8 +135,8 @@ UsedOutputs* getUsedOutputs();
 Mappings* getRuntimeMappings();
 
 /**
- * Trigger to update the respective nodeIDMapping. This method would make sure this update is permanent (e.g. storing it into DAO) 
- * and at the same time update any runtime structures holding the data. The caller has to make sure all previous mappings are also set,
+ * Trigger to update the respective nodeIDMapping. This method would make sure this update is permanent (e.g. queueing it to be stored into DAO,
+ * see daoQueue.h) and at the same time update any runtime structures holding the data right away. The caller has to make sure all previous mappings are also set,
  * otherwise this would be ignored
  * 
  * @param mappingNumber
@@ -127,6 +145,21 @@ Mappings* getRuntimeMappings();
  */
 void updateMapping (byte mappingNumber, byte mappingNodeID, byte mappingOutputNumber);
 
+/**
+ * The same as updateMapping, but the runtime nodeID lookup is not rebuilt, so that many mappings can be updated in a row cheaply.
+ * Until commitMappings is called, the new mappings are stored and reported in runtime mappings, but not used to switch outputs yet
+ * 
+ * @param mappingNumber
+ * @param mappingNodeID
+ * @param mappingOutputNumber
+ */
+void stageMapping (byte mappingNumber, byte mappingNodeID, byte mappingOutputNumber);
+
+/**
+ * Rebuilds the runtime nodeID lookup from all mappings, i.e. makes all mappings staged so far effective. Also updates the mapping image header
+ */
+void commitMappings();
+
 #ifdef	__cplusplus
 }
 #endif
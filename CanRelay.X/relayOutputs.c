@@ -0,0 +1,190 @@
+/* 
+ * Relay outputs implementation - port batched output engine using LAT shadow registers
+ * 
+ * File:   relayOutputs.c
+ * Author: pojd
+ *
+ * Created on November 24, 2018, 9:20 PM
+ */
+
+#include "relayOutputs.h"
+
+/** 
+ * Static output array to list all port and bit shifts.
+ * 
+ * Each line/array item here matches 1 label in output on relay silkscreen. I.e. line 1 matches label 1 on ground floor, line 2 label 2, etc. 
+ * Strictly speaking when accessing, for output x, index x-1 should be used since as usual, arrays are indexed from 0
+ * 
+ * It should match can-pcb schematic of pin outputs on the chip. See https://github.com/PoJD/can-pcb/tree/master/CanRelay for details
+ */
+Output outputs[OUTPUTS_COUNT] = { 
+    { &PORTD, 7 }, // RD7  O1
+    { &PORTB, 0 }, // RB0  O2
+    { &PORTD, 6 }, // RD6  O3
+    { &PORTB, 1 }, // RB1  O4
+    { &PORTD, 5 }, // RD5  O5
+    { &PORTB, 4 }, // RB4  O6
+    { &PORTD, 4 }, // RD4  O7
+    { &PORTB, 5 }, // RB5  O8
+    { &PORTC, 7 }, // RC7  O9
+    { &PORTB, 6 }, // RB6  O10
+    { &PORTC, 6 }, // RC6  O11
+    { &PORTB, 7 }, // RB7  O12
+    { &PORTC, 5 }, // RC5  O13
+    { &PORTA, 0 }, // RA0  O14
+    { &PORTC, 4 }, // RC4  O15
+    { &PORTA, 1 }, // RA1  O16
+    { &PORTD, 3 }, // RD3  O17
+    { &PORTA, 2 }, // RA2  O18
+    { &PORTD, 2 }, // RD2  O19
+    { &PORTA, 3 }, // RA3  O20
+    { &PORTD, 1 }, // RD1  O21
+    { &PORTA, 5 }, // RA5  O22
+    { &PORTD, 0 }, // RD0  O23
+    { &PORTE, 0 }, // RE0  O24
+    { &PORTC, 3 }, // RC3  O25
+    { &PORTE, 1 }, // RE1  O26
+    { &PORTC, 2 }, // RC2  O27
+    { &PORTE, 2 }, // RE2  O28
+    { &PORTC, 1 }, // RC1  O29
+    { &PORTC, 0 }, // RC0  O30
+};
+
+/**
+ * All ports used by the outputs above. Index of a port in this array is also the index of the mask in OutputSet for that port
+ */
+volatile byte* ports[PORTS_COUNT] = { &PORTA, &PORTB, &PORTC, &PORTD, &PORTE };
+
+/**
+ * LAT registers of the ports above (in the same order). Outputs are always written to LAT, never read-modify-written via PORT,
+ * so that the actual pin levels (e.g. relay coil still switching) never leak into other outputs of the same port
+ */
+volatile byte* lats[PORTS_COUNT] = { &LATA, &LATB, &LATC, &LATD, &LATE };
+
+/**
+ * Shadow copy of the LAT registers above - the only source of truth for the output status
+ */
+byte latShadows[PORTS_COUNT];
+
+/**
+ * Port index (into ports above) and bit mask of each output, precomputed from the outputs array in initOutputs
+ */
+byte outputPortIndexes[OUTPUTS_COUNT];
+byte outputMasks[OUTPUTS_COUNT];
+
+/*
+ * Private methods
+ */
+
+byte portIndex(volatile byte* port) {
+    // outputs are defined statically above, so the port is always found (the loop ends at the last port anyway)
+    byte i = 0;
+    for (; i<PORTS_COUNT-1; i++) {
+        if (ports[i] == port) {
+            break;
+        }
+    }
+    return i;
+}
+
+/*
+ * API methods
+ */
+
+void initOutputs() {
+    for (byte i=0; i<OUTPUTS_COUNT; i++) {
+        outputPortIndexes[i] = portIndex(outputs[i].port);
+        outputMasks[i] = 1 << outputs[i].portBit;
+    }
+    
+    for (byte i=0; i<PORTS_COUNT; i++) {
+        latShadows[i] = 0;
+        *lats[i] = 0;
+    }
+}
+
+void clearOutputSet(OutputSet* outputSet) {
+    for (byte i=0; i<PORTS_COUNT; i++) {
+        outputSet->masks[i] = 0;
+    }
+}
+
+void addOutputToSet(OutputSet* outputSet, byte outputNumber) {
+    outputSet->masks[outputPortIndexes[outputNumber-1]] |= outputMasks[outputNumber-1];
+}
+
+void performOperation(Operation operation, OutputSet* outputSet) {
+    // all outputs of the set in one pass, at most 1 write per port
+    for (byte i=0; i<PORTS_COUNT; i++) {
+        byte mask = outputSet->masks[i];
+        if (!mask) {
+            continue;
+        }
+        
+        // see http://stackoverflow.com/questions/47981/how-do-you-set-clear-and-toggle-a-single-bit-in-c-c
+        switch (operation) {
+            case TOGGLE:
+                latShadows[i] ^= mask;
+                break;
+            case ON:
+                latShadows[i] |= mask;
+                break;
+            case OFF:
+                latShadows[i] &= ~mask;
+                break;
+            default:
+                continue;
+        }
+        *lats[i] = latShadows[i];
+    }
+}
+
+void applyOutputSets(OutputSet* onSet, OutputSet* offSet) {
+    for (byte i=0; i<PORTS_COUNT; i++) {
+        byte onMask = onSet->masks[i];
+        byte offMask = offSet->masks[i];
+        if (!(onMask | offMask)) {
+            continue;
+        }
+        latShadows[i] = (latShadows[i] & ~offMask) | onMask;
+        *lats[i] = latShadows[i];
+    }
+}
+
+boolean isOutputInSet(OutputSet* outputSet, byte outputNumber) {
+    return (outputSet->masks[outputPortIndexes[outputNumber-1]] & outputMasks[outputNumber-1]) ? TRUE : FALSE;
+}
+
+void outputSetToBitmask(OutputSet* outputSet, byte* bitmask) {
+    for (byte i=0; i<(OUTPUTS_COUNT+7)/8; i++) {
+        bitmask[i] = 0;
+    }
+    for (byte outputNumber=1; outputNumber<=OUTPUTS_COUNT; outputNumber++) {
+        if (isOutputInSet(outputSet, outputNumber)) {
+            bitmask[(outputNumber-1) / 8] |= 1 << (7 - (outputNumber-1) % 8);
+        }
+    }
+}
+
+boolean isOutputOn(byte outputNumber) {
+    return (latShadows[outputPortIndexes[outputNumber-1]] & outputMasks[outputNumber-1]) ? TRUE : FALSE;
+}
+
+void getOutputState(OutputSet* outputState) {
+    for (byte i=0; i<PORTS_COUNT; i++) {
+        outputState->masks[i] = latShadows[i];
+    }
+}
+
+void restoreOutputState(OutputSet* outputState) {
+    OutputSet allOutputs;
+    clearOutputSet(&allOutputs);
+    for (byte outputNumber=1; outputNumber<=OUTPUTS_COUNT; outputNumber++) {
+        addOutputToSet(&allOutputs, outputNumber);
+    }
+    
+    for (byte i=0; i<PORTS_COUNT; i++) {
+        latShadows[i] = outputState->masks[i] & allOutputs.masks[i];
+        *lats[i] = latShadows[i];
+    }
+}
@@ -0,0 +1,131 @@
+/* 
+ * Relay outputs cover the physical outputs of the CanRelay board and the engine switching them. All output changes go through
+ * shadow copies of the LAT registers, so that any number of outputs is switched with at most one write per port.
+ * 
+ * File:   relayOutputs.h
+ * Author: pojd
+ *
+ * Created on November 24, 2018, 9:12 PM
+ */
+
+#ifndef RELAYOUTPUTS_H
+#define	RELAYOUTPUTS_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <xc.h>
+#include "utils.h"
+#include "can.h"
+
+/**
+ * Output structure represent the pair of reference to port and bit to change
+ * This is a static array inside the firmware to know how to translate from output numbers on the silk screen to individual port bits.
+ * 
+ * The same for each relay
+ */
+typedef struct {
+    volatile byte* port; // reference to one of the port registers of the chip (e.g. PORTA, PORTB, etc)
+    byte portBit; // actual bit that is to be set/read in this map
+} Output;
+
+// how many outputs do physically exist on this CanRelay board? A board with more than 32 outputs (STATUS_OUTPUTS) replies to GET in pages
+#define OUTPUTS_COUNT 30
+// how many ports are the outputs spread across (PORTA .. PORTE)
+#define PORTS_COUNT 5
+
+/**
+ * OutputSet represents any number of outputs as a bit mask per port (PORTA .. PORTE), so that operations on all of them 
+ * can be done in one pass with one write per port
+ */
+typedef struct {
+    byte masks[PORTS_COUNT];
+} OutputSet;
+
+/**
+ * Operations
+ */
+
+/**
+ * Initialize the outputs - precomputes port masks of all outputs and switches all outputs off. Has to be called before any other method in this header file.
+ */
+void initOutputs();
+
+/**
+ * Clears the in passed output set, i.e. no output would be in it after this call
+ * 
+ * @param outputSet output set to clear
+ */
+void clearOutputSet(OutputSet* outputSet);
+
+/**
+ * Adds the output to the in passed output set
+ * 
+ * @param outputSet output set to add the output to
+ * @param outputNumber number of the output to add (indexed from 1 to match silkscreen labels), has to be in range 1..OUTPUTS_COUNT
+ */
+void addOutputToSet(OutputSet* outputSet, byte outputNumber);
+
+/**
+ * Performs the operation on all outputs in the in passed set at once. Only the LAT shadow is changed per output, each port is then written just once
+ * 
+ * @param operation operation to perform (TOGGLE, ON or OFF, GET is ignored)
+ * @param outputSet all the outputs to perform the operation on
+ */
+void performOperation(Operation operation, OutputSet* outputSet);
+
+/**
+ * Switches off all outputs in the off set and switches on all outputs in the on set at once, with one write per port. Outputs in neither set are kept as they are
+ * 
+ * @param onSet all the outputs to switch on
+ * @param offSet all the outputs to switch off
+ */
+void applyOutputSets(OutputSet* onSet, OutputSet* offSet);
+
+/**
+ * Checks whether the output is in the in passed output set
+ * 
+ * @param outputSet output set to check
+ * @param outputNumber number of the output (indexed from 1 to match silkscreen labels), has to be in range 1..OUTPUTS_COUNT
+ * @return TRUE if the output is in the set, FALSE otherwise
+ */
+boolean isOutputInSet(OutputSet* outputSet, byte outputNumber);
+
+/**
+ * Converts the output set to a bit mask with 1 bit per output number, starting with the highest bit of the first byte for output 1
+ * 
+ * @param outputSet output set to convert
+ * @param bitmask where to write the mask to (4 bytes)
+ */
+void outputSetToBitmask(OutputSet* outputSet, byte* bitmask);
+
+/**
+ * Reads the current status of the output. The status is read from the LAT shadow, not from the port itself
+ * 
+ * @param outputNumber number of the output (indexed from 1 to match silkscreen labels), has to be in range 1..OUTPUTS_COUNT
+ * @return TRUE if the output is switched on, FALSE otherwise
+ */
+boolean isOutputOn(byte outputNumber);
+
+/**
+ * Gets the current status of all outputs, i.e. the set of all outputs switched on (as per the LAT shadows)
+ * 
+ * @param outputState where to copy the status to
+ */
+void getOutputState(OutputSet* outputState);
+
+/**
+ * Switches on exactly the outputs in the in passed set and switches off all others, with one write per port.
+ * Any bits not belonging to outputs are ignored
+ * 
+ * @param outputState set of all outputs to be switched on
+ */
+void restoreOutputState(OutputSet* outputState);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* RELAYOUTPUTS_H */
+
@@ -0,0 +1,105 @@
+/* 
+ * Relay scenes implementation - masks kept both as stored in EEPROM (for the readback) and as output sets (to apply them)
+ * 
+ * File:   relayScenes.c
+ * Author: pojd
+ *
+ * Created on December 8, 2018, 6:31 PM
+ */
+
+#include "relayScenes.h"
+#include "daoQueue.h"
+
+/** all scenes as stored in EEPROM */
+byte sceneMasks[SCENES_COUNT][SCENE_SIZE];
+
+/** all scenes as output sets */
+Scene scenes[SCENES_COUNT];
+
+/*
+ * Private methods
+ */
+
+void rebuildScene(byte sceneNumber) {
+    byte* onMask = sceneMasks[sceneNumber];
+    byte* offMask = onMask + SCENE_MASK_SIZE;
+    Scene* scene = &scenes[sceneNumber];
+    clearOutputSet(&scene->onSet);
+    clearOutputSet(&scene->offSet);
+    
+    for (byte outputNumber=1; outputNumber<=OUTPUTS_COUNT; outputNumber++) {
+        byte index = (outputNumber-1) / 8;
+        byte bit = 1 << (7 - (outputNumber-1) % 8);
+        boolean on = (onMask[index] & bit) ? TRUE : FALSE;
+        boolean off = (offMask[index] & bit) ? TRUE : FALSE;
+        
+        // set in both means keep as well
+        if (on && !off) {
+            addOutputToSet(&scene->onSet, outputNumber);
+        } else if (off && !on) {
+            addOutputToSet(&scene->offSet, outputNumber);
+        }
+    }
+}
+
+/*
+ * API methods
+ */
+
+void initScenes() {
+    readEeprom(SCENES_ADDRESS, (byte*) sceneMasks, SCENES_COUNT * SCENE_SIZE);
+    for (byte i=0; i<SCENES_COUNT; i++) {
+        rebuildScene(i);
+    }
+}
+
+Scene* nodeIDToScene(byte nodeID) {
+    // ignore the floor bit
+    byte sceneNodeID = nodeID & 0x7F;
+    if (sceneNodeID < SCENE_NODEID_OFFSET) {
+        return NULL;
+    }
+    return &scenes[sceneNodeID - SCENE_NODEID_OFFSET];
+}
+
+boolean isSceneUsed(byte sceneNumber) {
+    Scene* scene = &scenes[sceneNumber];
+    for (byte i=0; i<PORTS_COUNT; i++) {
+        if (scene->onSet.masks[i] | scene->offSet.masks[i]) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+void applyScene(Scene* scene) {
+    applyOutputSets(&scene->onSet, &scene->offSet);
+}
+
+void updateScene(byte sceneNumber, boolean onMask, byte* mask) {
+    if (sceneNumber >= SCENES_COUNT) {
+        return;
+    }
+    
+    byte offset = onMask ? 0 : SCENE_MASK_SIZE;
+    byte* sceneMask = sceneMasks[sceneNumber] + offset;
+    unsigned int address = SCENES_ADDRESS + sceneNumber * SCENE_SIZE + offset;
+    
+    for (byte i=0; i<SCENE_MASK_SIZE; i+=2) {
+        sceneMask[i] = mask[i];
+        sceneMask[i+1] = mask[i+1];
+        queueEepromWord(address + i, (mask[i] << 8) | mask[i+1]);
+    }
+    rebuildScene(sceneNumber);
+}
+
+boolean retrieveScene(byte sceneNumber, byte* data) {
+    if (sceneNumber >= SCENES_COUNT) {
+        return FALSE;
+    }
+    
+    for (byte i=0; i<SCENE_SIZE; i++) {
+        data[i] = sceneMasks[sceneNumber][i];
+    }
+    return TRUE;
+}
@@ -0,0 +1,103 @@
+/* 
+ * Relay scenes - presets of outputs to switch on and off at once (e.g. "evening" or "cleaning" lighting in a room), triggered by a single CAN message.
+ * 
+ * Each scene has a mask of outputs to switch on and a mask of outputs to switch off, all other outputs are kept as they are. The masks have 1 bit
+ * per output, starting with the highest bit of the first byte for output 1 (the same encoding as the output status in COMPLEX_REPLY). 
+ * An output set in both masks is kept too, so a scene never set in EEPROM (all bits set) does nothing.
+ * 
+ * A scene is triggered by NORMAL or COMPLEX messages for nodeIDs floor + SCENE_NODEID_OFFSET + scene number (ON or TOGGLE operation)
+ * 
+ * File:   relayScenes.h
+ * Author: pojd
+ *
+ * Created on December 8, 2018, 6:15 PM
+ */
+
+#ifndef RELAYSCENES_H
+#define	RELAYSCENES_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include "utils.h"
+#include "canSwitches.h"
+#include "relayOutputs.h"
+#include "outputPersistence.h"
+
+// number of scenes per relay
+#define SCENES_COUNT 16
+// size of the on and off masks of one scene (bit per output)
+#define SCENE_MASK_SIZE 4
+
+/**
+ * Scenes are stored right after the output persistence data, each scene has the on mask followed by the off mask
+ */
+#define SCENES_ADDRESS OUTPUT_PERSISTENCE_END_ADDRESS
+#define SCENE_SIZE (2 * SCENE_MASK_SIZE)
+#define SCENES_END_ADDRESS (SCENES_ADDRESS + SCENES_COUNT * SCENE_SIZE)
+
+/**
+ * Scene as used at runtime - outputs to switch on and off as per port masks, so that the whole scene is applied in one pass
+ */
+typedef struct {
+    OutputSet onSet;
+    OutputSet offSet;
+} Scene;
+
+/**
+ * Operations
+ */
+
+/**
+ * Loads all scenes from EEPROM. Outputs have to be initialized first (see initOutputs)
+ */
+void initScenes();
+
+/**
+ * Gets the scene triggered by the nodeID
+ * 
+ * @param nodeID received nodeID
+ * @return reference to the scene or NULL if the nodeID is not a scene nodeID
+ */
+Scene* nodeIDToScene(byte nodeID);
+
+/**
+ * Checks whether the scene switches any output at all
+ * 
+ * @param sceneNumber number of the scene (0..SCENES_COUNT-1)
+ * @return TRUE if the scene switches at least 1 output, FALSE otherwise
+ */
+boolean isSceneUsed(byte sceneNumber);
+
+/**
+ * Applies the scene - switches on and off all its outputs at once
+ * 
+ * @param scene scene to apply
+ */
+void applyScene(Scene* scene);
+
+/**
+ * Sets and stores the new mask of the scene
+ * 
+ * @param sceneNumber number of the scene (0..SCENES_COUNT-1), ignored if out of range
+ * @param onMask TRUE to set the mask of outputs to switch on, FALSE to set the mask of outputs to switch off
+ * @param mask the mask itself (SCENE_MASK_SIZE bytes)
+ */
+void updateScene(byte sceneNumber, boolean onMask, byte* mask);
+
+/**
+ * Retrieves both masks of the scene - SCENE_MASK_SIZE bytes of the on mask followed by SCENE_MASK_SIZE bytes of the off mask
+ * 
+ * @param sceneNumber number of the scene (0..SCENES_COUNT-1)
+ * @param data where to write the masks to
+ * @return TRUE if the masks were written, FALSE if the scene number is out of range
+ */
+boolean retrieveScene(byte sceneNumber, byte* data);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* RELAYSCENES_H */
+
@@ -0,0 +1,198 @@
+/* 
+ * Relay timers implementation - hashed timer wheel, each slot being a doubly linked list of timers (at most 1 timer per output)
+ * 
+ * File:   relayTimers.c
+ * Author: pojd
+ *
+ * Created on December 10, 2018, 8:05 PM
+ */
+
+#include "relayTimers.h"
+#include "daoQueue.h"
+
+// marker of no timer in the links and slots below
+#define NO_LINK MAX_8_BITS
+
+/** timer config (mode and time) of each output */
+unsigned int timerConfigs[OUTPUTS_COUNT];
+
+/** all outputs with PULSE timers */
+OutputSet pulseOutputs;
+
+/** heads of timer lists of each wheel slot (output index or NO_LINK) */
+byte wheelSlots[TIMER_WHEEL_SIZE];
+
+/** 
+ * Running timers - indexed by output index (output number - 1). Slot of the timer in the wheel (NO_LINK if not running), links to 
+ * the previous and next timer in the same slot and the number of full turns of the wheel to wait for before the timer expires
+ */
+byte timerSlots[OUTPUTS_COUNT];
+byte timerPrevious[OUTPUTS_COUNT];
+byte timerNext[OUTPUTS_COUNT];
+unsigned int timerTurns[OUTPUTS_COUNT];
+
+/** ticks counted by the interrupt and the last tick processed by the main loop (both free running) */
+volatile byte wheelTicks = 0;
+byte wheelPosition = 0;
+
+/*
+ * Private methods
+ */
+
+TimerMode timerMode(byte outputIndex) {
+    return (timerConfigs[outputIndex] >> 14) & 0b11;
+}
+
+void stopTimer(byte outputIndex) {
+    byte slot = timerSlots[outputIndex];
+    if (slot == NO_LINK) {
+        return;
+    }
+    
+    byte previous = timerPrevious[outputIndex];
+    byte next = timerNext[outputIndex];
+    if (previous == NO_LINK) {
+        wheelSlots[slot] = next;
+    } else {
+        timerNext[previous] = next;
+    }
+    if (next != NO_LINK) {
+        timerPrevious[next] = previous;
+    }
+    timerSlots[outputIndex] = NO_LINK;
+}
+
+void startTimer(byte outputIndex) {
+    // restart if already running
+    stopTimer(outputIndex);
+    
+    unsigned int time = timerConfigs[outputIndex] & MAX_TIMER_TIME;
+    if (!time) {
+        time = 1;
+    }
+    
+    // the slot is reached first after 1..TIMER_WHEEL_SIZE ticks, then after each full turn again
+    byte slot = (wheelPosition + time) & (TIMER_WHEEL_SIZE-1);
+    timerTurns[outputIndex] = (time-1) / TIMER_WHEEL_SIZE;
+    timerSlots[outputIndex] = slot;
+    timerPrevious[outputIndex] = NO_LINK;
+    timerNext[outputIndex] = wheelSlots[slot];
+    if (wheelSlots[slot] != NO_LINK) {
+        timerPrevious[wheelSlots[slot]] = outputIndex;
+    }
+    wheelSlots[slot] = outputIndex;
+}
+
+void rebuildPulseOutputs() {
+    clearOutputSet(&pulseOutputs);
+    for (byte i=0; i<OUTPUTS_COUNT; i++) {
+        if (timerMode(i) == PULSE) {
+            addOutputToSet(&pulseOutputs, i+1);
+        }
+    }
+}
+
+/*
+ * API methods
+ */
+
+void initTimers() {
+    readEeprom(OUTPUT_TIMERS_ADDRESS, (byte*) timerConfigs, 2 * OUTPUTS_COUNT);
+    for (byte i=0; i<OUTPUTS_COUNT; i++) {
+        // stored higher 8 bits first
+        byte* config = (byte*) &timerConfigs[i];
+        timerConfigs[i] = (config[0] << 8) | config[1];
+        timerSlots[i] = NO_LINK;
+    }
+    for (byte i=0; i<TIMER_WHEEL_SIZE; i++) {
+        wheelSlots[i] = NO_LINK;
+    }
+    rebuildPulseOutputs();
+}
+
+void performTimedOperation(Operation operation, OutputSet* outputSet) {
+    OutputSet previousState;
+    getOutputState(&previousState);
+    
+    if (operation == TOGGLE) {
+        // pulse outputs are always switched on
+        OutputSet toggledSet, pulseSet;
+        for (byte i=0; i<PORTS_COUNT; i++) {
+            pulseSet.masks[i] = outputSet->masks[i] & pulseOutputs.masks[i];
+            toggledSet.masks[i] = outputSet->masks[i] & ~pulseOutputs.masks[i];
+        }
+        performOperation(TOGGLE, &toggledSet);
+        performOperation(ON, &pulseSet);
+        
+        // pulse already on is started again
+        for (byte i=0; i<PORTS_COUNT; i++) {
+            previousState.masks[i] &= ~pulseSet.masks[i];
+        }
+    } else {
+        performOperation(operation, outputSet);
+    }
+    
+    updateTimers(&previousState);
+}
+
+void updateTimers(OutputSet* previousState) {
+    OutputSet state;
+    getOutputState(&state);
+    
+    for (byte outputNumber=1; outputNumber<=OUTPUTS_COUNT; outputNumber++) {
+        byte outputIndex = outputNumber-1;
+        if (timerMode(outputIndex) != AUTO_OFF && timerMode(outputIndex) != PULSE) {
+            continue;
+        }
+        
+        boolean wasOn = isOutputInSet(previousState, outputNumber);
+        boolean isOn = isOutputInSet(&state, outputNumber);
+        if (isOn && !wasOn) {
+            startTimer(outputIndex);
+        } else if (wasOn && !isOn) {
+            stopTimer(outputIndex);
+        }
+    }
+}
+
+void tickTimers() {
+    wheelTicks++;
+}
+
+void processTimers() {
+    OutputSet expiredOutputs;
+    clearOutputSet(&expiredOutputs);
+    boolean expired = FALSE;
+    
+    while (wheelPosition != wheelTicks) {
+        wheelPosition++;
+        byte outputIndex = wheelSlots[wheelPosition & (TIMER_WHEEL_SIZE-1)];
+        
+        while (outputIndex != NO_LINK) {
+            byte next = timerNext[outputIndex];
+            if (timerTurns[outputIndex]) {
+                timerTurns[outputIndex]--;
+            } else {
+                stopTimer(outputIndex);
+                addOutputToSet(&expiredOutputs, outputIndex+1);
+                expired = TRUE;
+            }
+            outputIndex = next;
+        }
+    }
+    
+    if (expired) {
+        performOperation(OFF, &expiredOutputs);
+    }
+}
+
+void setOutputTimer(byte outputNumber, TimerMode mode, unsigned int time) {
+    if (outputNumber<=0 || outputNumber>OUTPUTS_COUNT) {
+        return;
+    }
+    
+    unsigned int timerConfig = (mode << 14) | (time & MAX_TIMER_TIME);
+    timerConfigs[outputNumber-1] = timerConfig;
+    queueEepromWord(OUTPUT_TIMERS_ADDRESS + 2 * (outputNumber-1), timerConfig);
+    rebuildPulseOutputs();
+}
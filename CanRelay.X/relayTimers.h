@@ -0,0 +1,98 @@
+/* 
+ * Relay timers switch outputs off after a configured time. Each output can have its timer set as:
+ * - AUTO_OFF - the output is switched off after the time since it was last switched on (e.g. a bathroom fan)
+ * - PULSE - the same, but the output is always switched on, TOGGLE never switches it off (e.g. a garage door held on for a short moment)
+ * 
+ * Running timers are kept in a hashed timer wheel, so that starting, stopping and advancing the timers does not depend on the number of timers running.
+ * The timer interrupt only moves the wheel by one tick (tickTimers), the timers expired are then switched off from the main loop (processTimers).
+ * The time is in quarters of a second, i.e. the same as the timer interrupt.
+ * 
+ * File:   relayTimers.h
+ * Author: pojd
+ *
+ * Created on December 10, 2018, 7:48 PM
+ */
+
+#ifndef RELAYTIMERS_H
+#define	RELAYTIMERS_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include "utils.h"
+#include "can.h"
+#include "relayOutputs.h"
+#include "relayScenes.h"
+
+/**
+ * Modes of output timers - stored in the highest 2 bits of the timer config, the rest being the time in quarters of a second
+ */
+typedef enum {
+    NO_TIMER = 0,
+    AUTO_OFF = 1,
+    PULSE = 2
+} TimerMode;
+
+// max time of one timer (14 bits, i.e. a bit more than an hour)
+#define MAX_TIMER_TIME MAX_14_BITS
+
+// number of slots in the wheel, has to be a power of 2 (and divide 256) since the ticks are free running bytes
+#define TIMER_WHEEL_SIZE 64
+
+/**
+ * Timer configs of all outputs (2 bytes per output) stored right after the scenes
+ */
+#define OUTPUT_TIMERS_ADDRESS SCENES_END_ADDRESS
+#define OUTPUT_TIMERS_END_ADDRESS (OUTPUT_TIMERS_ADDRESS + 2 * OUTPUTS_COUNT)
+
+/**
+ * Operations
+ */
+
+/**
+ * Loads timer configs of all outputs from EEPROM. Outputs have to be initialized first (see initOutputs)
+ */
+void initTimers();
+
+/**
+ * Performs the operation on all outputs in the set and starts or stops timers of all outputs switched on or off by that. 
+ * To be used instead of performOperation for any operation coming from outside
+ * 
+ * @param operation operation to perform
+ * @param outputSet all the outputs to perform the operation on
+ */
+void performTimedOperation(Operation operation, OutputSet* outputSet);
+
+/**
+ * Starts or stops timers of all outputs changed since the status in passed, i.e. to be called after outputs were switched other way than via performTimedOperation
+ * 
+ * @param previousState status of all outputs before the change (see getOutputState)
+ */
+void updateTimers(OutputSet* previousState);
+
+/**
+ * Moves the wheel by one tick, constant time regardless of the timers running. To be called from the timer interrupt only
+ */
+void tickTimers();
+
+/**
+ * Switches off all outputs of the timers expired since the last call (all at once). To be called regularly from the main loop
+ */
+void processTimers();
+
+/**
+ * Sets and stores the new timer config of the output. Any timer running for the output is kept running
+ * 
+ * @param outputNumber number of the output (indexed from 1), ignored if out of range
+ * @param mode timer mode
+ * @param time time in quarters of a second (up to MAX_TIMER_TIME)
+ */
+void setOutputTimer(byte outputNumber, TimerMode mode, unsigned int time);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* RELAYTIMERS_H */
+
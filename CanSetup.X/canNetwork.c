@@ -0,0 +1,128 @@
+/* 
+ * Network settings implementation
+ * 
+ * File:   canNetwork.c
+ * Author: pojd
+ *
+ * Created on December 16, 2018, 5:52 PM
+ */
+
+#include "canNetwork.h"
+#include "daoQueue.h"
+
+/**
+ * Bit timing of a supported bit rate - the BRGCON registers as listed by canBitTiming.py
+ */
+typedef struct {
+    unsigned int bitRate; // kbps
+    byte brgcon1;
+    byte brgcon2;
+    byte brgcon3;
+} BitTiming;
+
+/** bit rates with valid timing at CPU_SPEED on the installed 300m bus, the first timing listed by ./canBitTiming.py <bit rate> 300 each */
+const BitTiming bitTimings[] = {
+    { 20, 0x67, 0xA8, 0x01 },
+    { 50, 0xC9, 0xBA, 0x03 },
+    { 100, 0x83, 0xBF, 0x02 },
+    { 125, 0x43, 0xA7, 0x01 }
+};
+#define BIT_TIMINGS_COUNT (sizeof(bitTimings) / sizeof(bitTimings[0]))
+
+/** bit rate on trial (0 if none), the one to switch back to and the start of the trial */
+unsigned int trialBitRate = 0;
+unsigned int previousBitRate = 0;
+unsigned long trialStart = 0;
+
+/** error counters as of the first check of the trial, checked once baselined */
+boolean trialBaselined = FALSE;
+byte trialTransmitErrors = 0;
+byte trialReceiveErrors = 0;
+
+/*
+ * Private methods
+ */
+
+const BitTiming* findBitTiming(unsigned int bitRate) {
+    for (byte i=0; i<BIT_TIMINGS_COUNT; i++) {
+        if (bitTimings[i].bitRate == bitRate) {
+            return &bitTimings[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * API methods
+ */
+
+boolean isSupportedBitRate(unsigned int bitRate) {
+    return findBitTiming(bitRate) ? TRUE : FALSE;
+}
+
+void setupBitTiming(unsigned int bitRate) {
+    const BitTiming* bitTiming = findBitTiming(bitRate);
+    if (!bitTiming) {
+        bitTiming = findBitTiming(DEFAULT_BIT_RATE);
+    }
+    BRGCON1 = bitTiming->brgcon1;
+    BRGCON2 = bitTiming->brgcon2;
+    BRGCON3 = bitTiming->brgcon3;
+}
+
+boolean startBitRateTrial(unsigned int currentBitRate, unsigned int newBitRate, unsigned long time) {
+    if (!isSupportedBitRate(newBitRate) || newBitRate == currentBitRate) {
+        return FALSE;
+    }
+    
+    // another command during a trial starts over, but keeps the bit rate known to work
+    if (!trialBitRate) {
+        previousBitRate = currentBitRate;
+    }
+    trialBitRate = newBitRate;
+    trialStart = time;
+    trialBaselined = FALSE;
+    return TRUE;
+}
+
+unsigned int checkBitRateTrial(unsigned long time) {
+    if (!trialBitRate) {
+        return 0;
+    }
+    
+    if (!trialBaselined) {
+        trialTransmitErrors = TXERRCNT;
+        trialReceiveErrors = RXERRCNT;
+        trialBaselined = TRUE;
+    } else if (COMSTATbits.TXBO || TXERRCNT > trialTransmitErrors || RXERRCNT > trialReceiveErrors) {
+        // some node is not on the new bit rate, so back to the previous one
+        trialBitRate = 0;
+        return previousBitRate;
+    }
+    
+    if (time - trialStart >= BIT_RATE_TRIAL_QUARTERS) {
+        saveBitRate(trialBitRate);
+        trialBitRate = 0;
+    }
+    return 0;
+}
+
+unsigned int loadBitRate() {
+    DataItem dataItem = dao_loadDataItem(BIT_RATE_DAO_BUCKET);
+    if (dao_isValid(&dataItem) && isSupportedBitRate(dataItem.value)) {
+        return dataItem.value;
+    }
+    return DEFAULT_BIT_RATE;
+}
+
+boolean saveBitRate(unsigned int bitRate) {
+    if (!isSupportedBitRate(bitRate)) {
+        return FALSE;
+    }
+    
+    DataItem dataItem;
+    dataItem.bucket = BIT_RATE_DAO_BUCKET;
+    dataItem.value = bitRate;
+    queueDataItem(&dataItem);
+    return TRUE;
+}
@@ -0,0 +1,107 @@
+/* 
+ * Settings and commands shared by all nodes on the CAN bus - the bit rate and network commands.
+ * 
+ * The bit rate is stored in the last DAO bucket of each node, any value not supported falls back to DEFAULT_BIT_RATE.
+ * Network commands are HEARTBEAT messages with nodeID NETWORK_NODE_ID (never used by any CanSwitch), first data byte being the command. 
+ * All nodes listening receive the very same message at the very same time, so e.g. the bit rate switch-over happens on all of them at once.
+ * 
+ * A node not listening at that time (e.g. a sleeping CanSwitch) would stay on the old bit rate though and split the bus. So a new bit rate is only used
+ * on trial first: it is stored only once the bus ran with no errors for BIT_RATE_TRIAL_QUARTERS, any error counter rising meanwhile switches the node
+ * back to the previous bit rate. Frames of a node left behind cause errors on all nodes switched, so all of them switch back then.
+ * 
+ * File:   canNetwork.h
+ * Author: pojd
+ *
+ * Created on December 16, 2018, 5:40 PM
+ */
+
+#ifndef CANNETWORK_H
+#define	CANNETWORK_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <xc.h>
+#include "utils.h"
+#include "dao.h"
+
+// bucket of the bit rate in DAO, the same for all nodes
+#define BIT_RATE_DAO_BUCKET 255
+
+// speed in kbps used unless a supported bit rate is stored
+#define DEFAULT_BIT_RATE 50
+// clock speed in MHz of all nodes (4 clocks made up 1 instruction)
+#define CPU_SPEED 16
+
+// nodeID of HEARTBEAT messages carrying network commands
+#define NETWORK_NODE_ID 0
+
+// network commands (first data byte)
+#define NETWORK_COMMAND_BIT_RATE 1 // new bit rate in kbps (2 bytes), stored and used right away
+#define NETWORK_COMMAND_SYNC 2 // start of a new heartbeat period on all CanSwitches (no more data)
+
+// time to watch the bus on a new bit rate before it is stored, in quarters of a second
+#define BIT_RATE_TRIAL_QUARTERS 40
+
+/**
+ * Operations
+ */
+
+/**
+ * Checks whether the bit rate is supported by all nodes, i.e. has a valid timing on the installed bus (see canBitTiming.py for the timing of each)
+ * 
+ * @param bitRate bit rate in kbps
+ * @return TRUE if supported, FALSE otherwise
+ */
+boolean isSupportedBitRate(unsigned int bitRate);
+
+/**
+ * Sets up the bit timing (BRGCON registers) validated by canBitTiming.py for the bit rate. Has to be called in CAN CONFIG mode
+ * 
+ * @param bitRate bit rate in kbps, DEFAULT_BIT_RATE is used if not supported
+ */
+void setupBitTiming(unsigned int bitRate);
+
+/**
+ * Loads the bit rate from DAO
+ * 
+ * @return bit rate stored in DAO or DEFAULT_BIT_RATE if not stored or not supported
+ */
+unsigned int loadBitRate();
+
+/**
+ * Starts the trial of a new bit rate received in the network command. The caller has to switch to the new bit rate right after (see setupBitTiming)
+ * and then check the trial regularly (see checkBitRateTrial)
+ * 
+ * @param currentBitRate bit rate in kbps used now, to switch back to if the trial fails
+ * @param newBitRate new bit rate in kbps
+ * @param time actual time in quarters of a second
+ * @return TRUE if the trial started, FALSE if the new bit rate is not supported or the same as the current one (nothing to switch then)
+ */
+boolean startBitRateTrial(unsigned int currentBitRate, unsigned int newBitRate, unsigned long time);
+
+/**
+ * Checks the trial of a new bit rate, if any. If the CAN error counters rose since the first check (or the CAN module is in bus-off), the trial ends
+ * and the caller has to switch back. Once the trial time passes with no errors, the new bit rate gets stored (see saveBitRate).
+ * To be called regularly, at least once the new bit rate is used (after CAN is switched to the NORMAL mode)
+ * 
+ * @param time actual time in quarters of a second
+ * @return bit rate in kbps to switch back to, 0 if nothing to switch
+ */
+unsigned int checkBitRateTrial(unsigned long time);
+
+/**
+ * Stores the bit rate into DAO (in the background, see daoQueue.h)
+ * 
+ * @param bitRate bit rate in kbps, ignored if not supported
+ * @return TRUE if the bit rate is supported and stored, FALSE otherwise
+ */
+boolean saveBitRate(unsigned int bitRate);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* CANNETWORK_H */
+
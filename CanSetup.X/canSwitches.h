@@ -57,6 +57,9 @@ typedef enum {
     FIRST = 0b10000000
 } Floor;
 
+// nodeIDs of scenes within a floor (the last 16 nodeIDs, not used by any CanSwitch), see CanRelay.X/relayScenes.h
+#define SCENE_NODEID_OFFSET 0x70
+
 #ifdef	__cplusplus
 }
 #endif
@@ -0,0 +1,160 @@
+/* 
+ * Write-behind DAO queue implementation - writes EEPROM bytes directly, one at a time
+ * 
+ * File:   daoQueue.c
+ * Author: pojd
+ *
+ * Created on December 2, 2018, 8:27 PM
+ */
+
+#include "daoQueue.h"
+
+/**
+ * Queued write of 2 bytes - DAO bucket already translated to its address
+ */
+typedef struct {
+    unsigned int address;
+    unsigned int value;
+} QueuedWrite;
+
+/** queued writes, the one being written first */
+QueuedWrite daoQueue[DAO_QUEUE_SIZE];
+byte daoQueueSize = 0;
+
+/** next byte of the first queued write to be written */
+byte daoQueueByteIndex = 0;
+
+/** set when a byte write is started and cleared by the EEIF interrupt */
+volatile boolean daoWriteInProgress = FALSE;
+
+/*
+ * Private methods
+ */
+
+/**
+ * Starts writing the byte to the address given, unless EEPROM already holds this value (saves both time and EEPROM wear)
+ * 
+ * @return TRUE if the write was started, FALSE if not needed
+ */
+boolean startByteWrite(unsigned int address, byte value) {
+    EEADRH = (address >> 8) & MAX_8_BITS;
+    EEADR = address & MAX_8_BITS;
+    // access data EEPROM
+    EECON1bits.EEPGD = 0;
+    EECON1bits.CFGS = 0;
+    
+    EECON1bits.RD = 1;
+    if (EEDATA == value) {
+        return FALSE;
+    }
+    
+    EEDATA = value;
+    daoWriteInProgress = TRUE;
+    PIE4bits.EEIE = 1;
+    EECON1bits.WREN = 1;
+    
+    // required sequence must not be interrupted. Clear any EEIF left over first, so that only the end of this write can set it
+    boolean interruptsEnabled = INTCONbits.GIE;
+    INTCONbits.GIE = 0;
+    PIR4bits.EEIF = 0;
+    EECON2 = 0x55;
+    EECON2 = 0xAA;
+    EECON1bits.WR = 1;
+    INTCONbits.GIE = interruptsEnabled;
+    
+    // the write goes on on its own, so disable further writes right away
+    EECON1bits.WREN = 0;
+    return TRUE;
+}
+
+void removeFirstWrite() {
+    daoQueueSize--;
+    for (byte i=0; i<daoQueueSize; i++) {
+        daoQueue[i] = daoQueue[i+1];
+    }
+    daoQueueByteIndex = 0;
+}
+
+/*
+ * API methods
+ */
+
+void queueEepromWord(unsigned int address, unsigned int value) {
+    for (byte i=0; i<daoQueueSize; i++) {
+        if (daoQueue[i].address == address) {
+            daoQueue[i].value = value;
+            if (i == 0) {
+                // the bucket could be written partially already, so start again to write the new value as a whole
+                daoQueueByteIndex = 0;
+            }
+            return;
+        }
+    }
+    
+    if (daoQueueSize == DAO_QUEUE_SIZE) {
+        // no space left, so write the oldest one synchronously first (finishing the byte in progress), the rest continues afterwards
+        while (daoQueueSize == DAO_QUEUE_SIZE) {
+            while (EECON1bits.WR);
+            PIR4bits.EEIF = 0;
+            daoWriteInProgress = FALSE;
+            processDaoQueue();
+        }
+    }
+    
+    QueuedWrite* queuedWrite = &daoQueue[daoQueueSize++];
+    queuedWrite->address = address;
+    queuedWrite->value = value;
+}
+
+void queueDataItem(DataItem* dataItem) {
+    queueEepromWord(dataItem->bucket * DAO_BUCKET_SIZE, dataItem->value);
+}
+
+void readEeprom(unsigned int address, byte* data, unsigned int length) {
+    while (EECON1bits.WR);
+    EECON1bits.EEPGD = 0;
+    EECON1bits.CFGS = 0;
+    
+    for (unsigned int i=0; i<length; i++, address++) {
+        EEADRH = (address >> 8) & MAX_8_BITS;
+        EEADR = address & MAX_8_BITS;
+        EECON1bits.RD = 1;
+        *data++ = EEDATA;
+    }
+}
+
+void processDaoQueue() {
+    // the hardware is the authority on a write still running (EEIF could be stale), EEADR and EEDATA must not be touched meanwhile
+    if (EECON1bits.WR) {
+        return;
+    }
+    // loop only over bytes not needing a write, i.e. at most one write is started
+    while (!daoWriteInProgress && daoQueueSize) {
+        QueuedWrite* queuedWrite = &daoQueue[0];
+        unsigned int address = queuedWrite->address + daoQueueByteIndex;
+        byte value = (daoQueueByteIndex == 0) ? (queuedWrite->value >> 8) & MAX_8_BITS : queuedWrite->value & MAX_8_BITS;
+        boolean started = startByteWrite(address, value);
+        
+        if (++daoQueueByteIndex == DAO_BUCKET_SIZE) {
+            removeFirstWrite();
+        }
+        if (started) {
+            return;
+        }
+    }
+}
+
+void checkDaoWriteCompleted() {
+    if (PIE4bits.EEIE && PIR4bits.EEIF) {
+        PIR4bits.EEIF = 0;
+        daoWriteInProgress = FALSE;
+    }
+}
+
+byte getDaoQueueSpace() {
+    return DAO_QUEUE_SIZE - daoQueueSize;
+}
+
+boolean isDaoQueueEmpty() {
+    return (daoQueueSize == 0 && !daoWriteInProgress) ? TRUE : FALSE;
+}
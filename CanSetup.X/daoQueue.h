@@ -0,0 +1,94 @@
+/* 
+ * Write-behind queue for DAO updates. Instead of blocking the CPU for milliseconds per each EEPROM byte written (dao_saveDataItem), 
+ * data items are queued and written one byte at a time from the main loop, the end of each byte write is signalled by the EEIF interrupt.
+ * Repeated writes to the same bucket are merged, so that only the latest value is written.
+ * 
+ * Shared by CanSwitch and CanRelay. Each main loop iteration should call processDaoQueue, the interrupt routine should call checkDaoWriteCompleted.
+ * 
+ * File:   daoQueue.h
+ * Author: pojd
+ *
+ * Created on December 2, 2018, 8:12 PM
+ */
+
+#ifndef DAOQUEUE_H
+#define	DAOQUEUE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <xc.h>
+#include "utils.h"
+#include "dao.h"
+
+// number of distinct buckets that can wait to be written (a burst of CONFIG messages plus an output snapshot of CanRelay)
+#define DAO_QUEUE_SIZE 16
+
+// layout of data items in EEPROM as used by the DAO - each bucket takes 2 bytes starting at byte bucket*2, higher 8 bits of the value first
+#define DAO_BUCKET_SIZE 2
+
+// first EEPROM address after all DAO buckets (256 buckets), free to be used directly by the applications
+#define EEPROM_FREE_ADDRESS 512
+
+/**
+ * Operations
+ */
+
+/**
+ * Queues the data item to be written into EEPROM. If the bucket is already queued, only its value is updated.
+ * Only if the queue is full, the oldest queued writes are finished synchronously first (blocking the same way as dao_saveDataItem).
+ * 
+ * @param dataItem data item to store
+ */
+void queueDataItem(DataItem* dataItem);
+
+/**
+ * Queues the 2 bytes value to be written into EEPROM at the address given (higher 8 bits first), i.e. the same as queueDataItem, 
+ * but outside of DAO buckets (see EEPROM_FREE_ADDRESS).
+ * 
+ * @param address EEPROM address of the first byte to write
+ * @param value value to write
+ */
+void queueEepromWord(unsigned int address, unsigned int value);
+
+/**
+ * Reads the EEPROM bytes in one go - waits for the current byte write to finish first. Any queued writes are not taken into account
+ * 
+ * @param address EEPROM address of the first byte to read
+ * @param data where to read the bytes to
+ * @param length number of bytes to read
+ */
+void readEeprom(unsigned int address, byte* data, unsigned int length);
+
+/**
+ * Starts writing the next byte of the queued data items if no write is currently in progress. To be called on each main loop iteration
+ */
+void processDaoQueue();
+
+/**
+ * Checks whether the EEPROM write finished and if so, allows the next byte to be written. To be called from the interrupt routine
+ */
+void checkDaoWriteCompleted();
+
+/**
+ * Gets the number of new addresses that can be queued right now without blocking (updates of an address queued already always fit).
+ * Allows callers with bursts of writes (e.g. CONFIG messages) to hold them back till the queue drains instead of blocking
+ * 
+ * @return number of free entries in the queue
+ */
+byte getDaoQueueSpace();
+
+/**
+ * Checks whether all queued data items were already written
+ * 
+ * @return TRUE if nothing is waiting to be written, FALSE otherwise
+ */
+boolean isDaoQueueEmpty();
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* DAOQUEUE_H */
+
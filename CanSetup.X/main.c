@@ -10,6 +10,7 @@
 #include "config.h"
 #include "canSwitches.h"
 #include "dao.h"
+#include "canNetwork.h"
 
 /*
  * Sets up EEPROM of this node as a canSwitch - using the node passed in to be set as NODE_ID for CanSwitch project
@@ -38,6 +39,16 @@ void setupCanRelay(Floor floor) {
     dao_saveDataItem(&dataItem);    
 }
 
+/*
+ * Sets up the bit rate of this node (any node type) - has to be the same for all nodes on the bus, see canBitTiming.py for the bit rates supported
+ */
+void setupBitRate(unsigned int bitRate) {
+    DataItem dataItem;
+    dataItem.bucket = BIT_RATE_DAO_BUCKET;
+    dataItem.value = bitRate;
+    dao_saveDataItem(&dataItem);
+}
+
 int main(void) {
     // for example setup as CanSwitch a room
     setupCanSwitch(GARAGE_109);
@@ -47,6 +58,9 @@ int main(void) {
     // or setup as CanRelay for ground floor
     //setupCanRelay(FIRST);
     
+    // optionally also a bit rate other than default
+    //setupBitRate(125);
+    
     for (int i=0; i<1000; i++) {
         NOP();
     }
@@ -29,7 +29,7 @@ extern "C" {
 #pragma config FOSC = HS1       // Oscillator (HS oscillator (Medium power, 4 MHz - 16 MHz))
 #pragma config PLLCFG = OFF     // PLL x4 Enable bit (Disabled)
 #pragma config FCMEN = OFF      // Fail-Safe Clock Monitor (Disabled)
-#pragma config IESO = OFF       // Internal External Oscillator Switch Over Mode (Disabled)
+#pragma config IESO = ON        // Internal External Oscillator Switch Over Mode (Enabled)
 
 // CONFIG2L
 #pragma config PWRTEN = ON      // Power Up Timer (Enabled)
@@ -38,8 +38,8 @@ extern "C" {
 #pragma config BORPWR = ZPBORMV // BORMV Power level (ZPBORMV instead of BORMV is selected)
 
 // CONFIG2H
-#pragma config WDTEN = OFF      // Watchdog Timer (WDT disabled in hardware; SWDTEN bit disabled)
-#pragma config WDTPS = 1048576  // Watchdog Postscaler (1:1048576)
+#pragma config WDTEN = SWDTEN   // Watchdog Timer (WDT controlled by SWDTEN bit setting)
+#pragma config WDTPS = 16       // Watchdog Postscaler (1:16)
 
 // CONFIG3H
 #pragma config CANMX = PORTC    // ECAN Mux bit (ECAN TX and RX pins are located on RC6 and RC7, respectively)
@@ -0,0 +1,120 @@
+/* 
+ * Heartbeat scheduler implementation - all times in quarters of a second
+ * 
+ * File:   heartbeatScheduler.c
+ * Author: pojd
+ *
+ * Created on December 29, 2018, 3:32 PM
+ */
+
+#include "heartbeatScheduler.h"
+
+// 16 bit multiplicative hash constant (2^16 divided by the golden ratio, odd)
+#define NODE_ID_HASH 40503
+// taps of the 16 bit Galois LFSR used for the jitter
+#define JITTER_LFSR_TAPS 0xB400
+
+unsigned int heartbeatPeriod = 40;
+unsigned int heartbeatSlot = 0;
+/** quarters passed in the current period */
+unsigned int heartbeatPeriodTime = 0;
+
+/** TRUE once the slot came and till the heartbeat is sent */
+boolean heartbeatPending = FALSE;
+/** quarters left to wait with the pending heartbeat (jitter or backoff) */
+byte heartbeatDelay = 0;
+byte heartbeatBackoff = 1;
+
+volatile boolean busActivitySeen = FALSE;
+byte lastTransmitErrors = 0;
+
+unsigned int jitterLfsr = 1;
+
+/*
+ * Private methods
+ */
+
+byte nextJitter() {
+    // Galois LFSR, never gets to 0 as long as it is not seeded with 0
+    jitterLfsr = (jitterLfsr >> 1) ^ ((jitterLfsr & 1) ? JITTER_LFSR_TAPS : 0);
+    return jitterLfsr % HEARTBEAT_JITTER_QUARTERS;
+}
+
+boolean isBusBusy() {
+    return (busActivitySeen || TXERRCNT > lastTransmitErrors);
+}
+
+boolean sendHeartbeat() {
+    heartbeatPending = FALSE;
+    heartbeatBackoff = 1;
+    busActivitySeen = FALSE;
+    lastTransmitErrors = TXERRCNT;
+    return TRUE;
+}
+
+boolean scheduleHeartbeat() {
+    if (++heartbeatPeriodTime >= heartbeatPeriod) {
+        heartbeatPeriodTime = 0;
+    }
+    
+    if (heartbeatPeriodTime == heartbeatSlot) {
+        if (heartbeatPending) {
+            // not sent for the whole period, so do not wait any longer
+            return sendHeartbeat();
+        }
+        heartbeatPending = TRUE;
+        heartbeatDelay = nextJitter();
+    }
+    
+    if (!heartbeatPending) {
+        return FALSE;
+    }
+    if (heartbeatDelay) {
+        heartbeatDelay--;
+        return FALSE;
+    }
+    
+    if (isBusBusy()) {
+        // give the bus to others for a while, check again later
+        busActivitySeen = FALSE;
+        lastTransmitErrors = TXERRCNT;
+        heartbeatDelay = heartbeatBackoff;
+        if (heartbeatBackoff < HEARTBEAT_MAX_BACKOFF_QUARTERS) {
+            heartbeatBackoff *= 2;
+        }
+        return FALSE;
+    }
+    return sendHeartbeat();
+}
+
+/*
+ * API methods
+ */
+
+void setupHeartbeat(byte nodeID, unsigned int timeout) {
+    heartbeatPeriod = timeout * 4;
+    unsigned int hash = nodeID * NODE_ID_HASH;
+    // the high bits of the hash scaled to the period, the low bits keep the divisibility of the nodeID (steps of 8 would still collide)
+    heartbeatSlot = ((unsigned long) hash * heartbeatPeriod) >> 16;
+    // every switch gets a different sequence of jitters
+    jitterLfsr = hash | 1;
+    syncHeartbeat();
+}
+
+boolean heartbeatTick() {
+    boolean send = scheduleHeartbeat();
+    // only the bus activity seen during the last quarter tells the bus is busy right now
+    busActivitySeen = FALSE;
+    return send;
+}
+
+void heartbeatBusActivity() {
+    busActivitySeen = TRUE;
+}
+
+void syncHeartbeat() {
+    heartbeatPeriodTime = 0;
+    heartbeatPending = FALSE;
+    heartbeatDelay = 0;
+    heartbeatBackoff = 1;
+}
@@ -0,0 +1,70 @@
+/* 
+ * Heartbeat scheduler decides when this CanSwitch sends its heartbeat, so that heartbeats of all switches on the bus are spread evenly
+ * and never delay real switch presses.
+ * 
+ * Each period of the heartbeat timeout has 1 slot per quarter of a second. The slot of a switch is a hash of its nodeID (nodeIDs in steps of 8 would
+ * otherwise always collide), to which a small random jitter is added. When the time comes and the bus seems to be busy (bus activity seen during the last quarter,
+ * a message of ours lost arbitration or the transmit error count rose since the last heartbeat), the heartbeat is postponed with an exponential backoff.
+ * A heartbeat still not sent when its next slot comes is sent then anyway.
+ * 
+ * The periods start on startup, so switches powered up at the same time all keep their slots. A SYNC network command (see canNetwork.h) starts a new
+ * period on all switches at once, realigning all slots after e.g. some switches rebooted.
+ * 
+ * File:   heartbeatScheduler.h
+ * Author: pojd
+ *
+ * Created on December 29, 2018, 3:15 PM
+ */
+
+#ifndef HEARTBEATSCHEDULER_H
+#define	HEARTBEATSCHEDULER_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <xc.h>
+#include "utils.h"
+
+// max jitter added to the slot (in quarters of a second)
+#define HEARTBEAT_JITTER_QUARTERS 4
+// max backoff when the bus is busy (in quarters of a second)
+#define HEARTBEAT_MAX_BACKOFF_QUARTERS 16
+
+/**
+ * Operations
+ */
+
+/**
+ * Sets up the slot of the heartbeat and starts a new period. Can be called again later once the nodeID or the timeout change
+ * 
+ * @param nodeID nodeID of this switch
+ * @param timeout heartbeat timeout in seconds
+ */
+void setupHeartbeat(byte nodeID, unsigned int timeout);
+
+/**
+ * Processes another quarter of a second passed, also forgets the bus activity seen so far
+ * 
+ * @return TRUE if the heartbeat should be sent now
+ */
+boolean heartbeatTick();
+
+/**
+ * Marks activity seen on the bus (e.g. arbitration lost), so that the heartbeat backs off if it is to be sent
+ * within the next quarter of a second. Can be called from the interrupt
+ */
+void heartbeatBusActivity();
+
+/**
+ * Starts a new period, to be called when the SYNC network command is received. Never to be called from the interrupt, nor while heartbeatTick
+ * could be called from the interrupt meanwhile (interrupts have to be disabled then)
+ */
+void syncHeartbeat();
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* HEARTBEATSCHEDULER_H */
+
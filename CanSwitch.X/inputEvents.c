@@ -0,0 +1,61 @@
+/* 
+ * Input events implementation - a ring buffer with free running head and tail indexes.
+ * 
+ * Only the interrupt ever writes the head and only the main loop ever writes the tail. Both are single bytes, so written atomically
+ * and no interrupts need to be disabled (only to read the 2 byte overflow count). The entry is always written before the head is moved and read
+ * before the tail is moved.
+ * 
+ * File:   inputEvents.c
+ * Author: pojd
+ *
+ * Created on December 18, 2018, 9:14 PM
+ */
+
+#include <xc.h>
+#include "inputEvents.h"
+
+InputEvent inputEvents[INPUT_EVENT_QUEUE_SIZE];
+
+/** index of next entry to write (only changed by the interrupt) */
+volatile byte inputEventsHead = 0;
+/** index of next entry to read (only changed by the main loop) */
+volatile byte inputEventsTail = 0;
+
+/** number of events dropped due to the queue being full */
+volatile unsigned int inputEventOverflows = 0;
+
+boolean pushInputEvent(byte pin, InputEdge edge, byte tick) {
+    // indexes are free running, so their difference is the number of entries in the queue (even after they overflow)
+    if ((byte)(inputEventsHead - inputEventsTail) == INPUT_EVENT_QUEUE_SIZE) {
+        inputEventOverflows++;
+        return FALSE;
+    }
+    
+    InputEvent* inputEvent = &inputEvents[inputEventsHead & (INPUT_EVENT_QUEUE_SIZE-1)];
+    inputEvent->pin = pin;
+    inputEvent->edge = edge;
+    inputEvent->tick = tick;
+    
+    // only now make the entry visible to the main loop
+    inputEventsHead++;
+    return TRUE;
+}
+
+InputEvent* peekInputEvent() {
+    if (inputEventsHead == inputEventsTail) {
+        return NULL;
+    }
+    return &inputEvents[inputEventsTail & (INPUT_EVENT_QUEUE_SIZE-1)];
+}
+
+void popInputEvent() {
+    inputEventsTail++;
+}
+
+unsigned int getInputEventOverflows() {
+    // 2 bytes changed by the interrupt, so read them with the interrupts disabled
+    di();
+    unsigned int overflows = inputEventOverflows;
+    ei();
+    return overflows;
+}
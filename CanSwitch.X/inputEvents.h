@@ -0,0 +1,78 @@
+/* 
+ * Input events is a single producer / single consumer ring buffer of input changes detected on PORTB. The input interrupt pushes an event for each edge
+ * seen on any pin and the main loop drains and sends them in the order detected, so that no press is lost or merged while a CAN message is being sent.
+ * 
+ * File:   inputEvents.h
+ * Author: pojd
+ *
+ * Created on December 18, 2018, 9:05 PM
+ */
+
+#ifndef INPUTEVENTS_H
+#define	INPUTEVENTS_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include "utils.h"
+
+/**
+ * Edge of the input change. Inputs use weak pull ups, so pressing the wall switch pulls the pin low
+ */
+typedef enum {
+    PRESSED = 0, // falling edge on the pin
+    RELEASED = 1 // rising edge on the pin
+} InputEdge;
+
+/**
+ * One input change as detected by the interrupt
+ */
+typedef struct {
+    byte pin; // PORTB pin (0-7)
+    InputEdge edge; // edge detected
+    byte tick; // tick of the timebase the change was detected in (see inputGestures.h), wraps around
+} InputEvent;
+
+// size of the queue, has to be a power of 2 (and divide 256) since the indexes are free running bytes
+#define INPUT_EVENT_QUEUE_SIZE 16
+
+/**
+ * Operations
+ */
+
+/**
+ * Pushes a new event to the end of the queue. To be called from the interrupt only (the only producer)
+ * 
+ * @param pin PORTB pin changed
+ * @param edge edge detected
+ * @param tick tick of the timebase the change was detected in
+ * @return TRUE if the event was queued, FALSE if the queue was full and the event was dropped (and counted as overflow)
+ */
+boolean pushInputEvent(byte pin, InputEdge edge, byte tick);
+
+/**
+ * Gets the oldest event in the queue without removing it. To be called from the main loop only (the only consumer)
+ * 
+ * @return reference to the oldest event or NULL if the queue is empty
+ */
+InputEvent* peekInputEvent();
+
+/**
+ * Removes the oldest event from the queue, i.e. the one returned by peekInputEvent, making its space available to the interrupt again
+ */
+void popInputEvent();
+
+/**
+ * Gets the number of events dropped since start since the queue was full
+ * 
+ * @return overflow count
+ */
+unsigned int getInputEventOverflows();
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* INPUTEVENTS_H */
+
@@ -0,0 +1,107 @@
+/* 
+ * Input gestures implementation - per pin state machine with a debounce lockout and a gesture timeout, both counted down in ticks
+ * 
+ * File:   inputGestures.c
+ * Author: pojd
+ *
+ * Created on December 20, 2018, 8:51 PM
+ */
+
+#include "inputGestures.h"
+
+/**
+ * States of one input
+ */
+typedef enum {
+    IDLE,           // released, nothing pending
+    PRESSED_FIRST,  // pressed, waiting for release or long press
+    RELEASED_FIRST, // released after a short press, waiting for a second press
+    HELD            // pressed and gesture already reported, waiting for release
+} InputState;
+
+typedef struct {
+    InputState state;
+    byte lockout; // ticks left of the debounce lockout
+    byte timeout; // ticks left till the gesture timeout of the state
+} Input;
+
+Input inputs[INPUTS_COUNT];
+
+boolean gesturesEnabled = FALSE;
+
+/*
+ * Private methods
+ */
+
+boolean isStatePressed(InputState state) {
+    return (state == PRESSED_FIRST || state == HELD);
+}
+
+/*
+ * API methods
+ */
+
+void setGesturesEnabled(boolean enabled) {
+    gesturesEnabled = enabled;
+    for (byte i=0; i<INPUTS_COUNT; i++) {
+        inputs[i].state = IDLE;
+        inputs[i].lockout = 0;
+        inputs[i].timeout = 0;
+    }
+}
+
+Gesture inputEdge(byte pin, InputEdge edge) {
+    Input* input = &inputs[pin];
+    boolean pressed = (edge == PRESSED);
+    
+    // bouncing or edge already taken (e.g. when the level was checked at the end of the lockout)
+    if (input->lockout || pressed == isStatePressed(input->state)) {
+        return NO_GESTURE;
+    }
+    input->lockout = DEBOUNCE_TICKS;
+    
+    if (!gesturesEnabled) {
+        input->state = pressed ? HELD : IDLE;
+        return pressed ? SINGLE_PRESS : NO_GESTURE;
+    }
+    
+    switch (input->state) {
+        case IDLE:
+            input->state = PRESSED_FIRST;
+            input->timeout = LONG_PRESS_TICKS;
+            break;
+        case PRESSED_FIRST:
+            input->state = RELEASED_FIRST;
+            input->timeout = DOUBLE_PRESS_TICKS;
+            break;
+        case RELEASED_FIRST:
+            input->state = HELD;
+            input->timeout = 0;
+            return DOUBLE_PRESS;
+        case HELD:
+            input->state = IDLE;
+            break;
+    }
+    return NO_GESTURE;
+}
+
+Gesture inputTick(byte pin, boolean inputOn) {
+    Input* input = &inputs[pin];
+    
+    if (input->lockout && --input->lockout == 0 && inputOn != isStatePressed(input->state)) {
+        // an edge was missed during the lockout, so take it now
+        return inputEdge(pin, inputOn ? PRESSED : RELEASED);
+    }
+    
+    if (input->timeout && --input->timeout == 0) {
+        if (input->state == PRESSED_FIRST) {
+            input->state = HELD;
+            return LONG_PRESS;
+        }
+        if (input->state == RELEASED_FIRST) {
+            input->state = IDLE;
+            return SINGLE_PRESS;
+        }
+    }
+    return NO_GESTURE;
+}
@@ -0,0 +1,83 @@
+/* 
+ * Input gestures debounce the input changes on the switch itself and recognize what the user did with the wall switch: a single press, 
+ * a double press or a long press. Each pin has its own small state machine driven by the input edges (see inputEvents.h) and by ticks of a timebase.
+ * 
+ * The first edge on a pin is taken right away and any other edges on that pin are then ignored for DEBOUNCE_TICKS (leading edge debounce),
+ * so the bouncing of the wall switch never gets to the bus. If the pin level differs from the state when the lockout ends, the missed edge is taken then.
+ * 
+ * Without gestures enabled every press is a single press reported right away. With gestures enabled a single press is only reported once
+ * no second press came within DOUBLE_PRESS_TICKS after release, a press held for LONG_PRESS_TICKS is a long press.
+ * 
+ * File:   inputGestures.h
+ * Author: pojd
+ *
+ * Created on December 20, 2018, 8:32 PM
+ */
+
+#ifndef INPUTGESTURES_H
+#define	INPUTGESTURES_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include "utils.h"
+#include "inputEvents.h"
+
+// number of inputs (PORTB pins)
+#define INPUTS_COUNT 8
+
+// timebase of the gestures, 1 tick = 1/16 of a second (64ms of the watchdog in sleep)
+#define TICKS_PER_QUARTER_SEC 4
+// edges ignored after an edge taken
+#define DEBOUNCE_TICKS 2
+// max time between release and next press to make a double press
+#define DOUBLE_PRESS_TICKS 5
+// min time to hold the press to make a long press
+#define LONG_PRESS_TICKS 16
+
+/**
+ * Gestures recognized
+ */
+typedef enum {
+    NO_GESTURE = 0,
+    SINGLE_PRESS = 1,
+    DOUBLE_PRESS = 2,
+    LONG_PRESS = 3
+} Gesture;
+
+/**
+ * Operations
+ */
+
+/**
+ * Sets whether double and long presses should be recognized. Resets the state of all inputs
+ * 
+ * @param enabled TRUE to recognize all gestures, FALSE to only report single presses right away
+ */
+void setGesturesEnabled(boolean enabled);
+
+/**
+ * Processes one edge detected on a pin
+ * 
+ * @param pin pin of the edge
+ * @param edge edge detected
+ * @return gesture recognized right away or NO_GESTURE
+ */
+Gesture inputEdge(byte pin, InputEdge edge);
+
+/**
+ * Processes one tick of the timebase for a pin. Has to be called for all pins on each tick
+ * 
+ * @param pin pin to process
+ * @param inputOn current level of the pin (TRUE = pressed)
+ * @return gesture recognized after a timeout or NO_GESTURE
+ */
+Gesture inputTick(byte pin, boolean inputOn);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* INPUTGESTURES_H */
+
@@ -14,17 +14,35 @@
 #include "can.h"
 #include "dao.h"
 #include "canSwitches.h"
-
-#define BAUD_RATE 50 // speed in kbps
-#define CPU_SPEED 16 // clock speed in MHz (4 clocks made up 1 instruction)
-#define FIRMWARE_VERSION 0 // start with the lowest possible version value since we only can support 4 values max (0-3))
+#include "daoQueue.h"
+#include "canNetwork.h"
+#include "inputEvents.h"
+#include "inputGestures.h"
+#include "switchActions.h"
+#include "switchTransmit.h"
+#include "wakeLatency.h"
+#include "heartbeatScheduler.h"
+
+#define FIRMWARE_VERSION 1 // started with the lowest possible version value since we only can support 4 values max (0-3))
+#define TRANSCEIVER_WAKE_US 50 // time for the transceiver to get back from standby
+#define HEARTBEAT_LENGTH 6 // data length of the heartbeat itself
+#define DROP_DIAGNOSTICS_LENGTH 3 // data length of the heartbeat with the counters of things dropped
+#define LATENCY_DIAGNOSTICS_LENGTH 8 // data length of the heartbeat with wake latencies
+#define CONFIG_LISTEN_TICKS 8 // time to listen for CONFIG messages after a heartbeat opening the listen window (or after the last CONFIG message received)
+#define CONFIG_LISTEN_DEFAULT_INTERVAL 60 // heartbeats between listen windows unless set in OFF_ALL_FLAG_DAO_BUCKET (10 minutes with the default heartbeat)
 
 // Buckets of DAO attributes for the switch
 
 #define NODE_ID_DAO_BUCKET 0
 #define SUPPRESS_SWITCH_DAO_BUCKET 1
 #define HEARTBEAT_TIMEOUT_DAO_BUCKET 2
-#define OFF_ALL_FLAG_DAO_BUCKET 3
+#define OFF_ALL_FLAG_DAO_BUCKET 3 // flags below
+
+// Flags stored in OFF_ALL_FLAG_DAO_BUCKET
+#define OFF_ALL_FLAG 0b01 // send OFF to all floors on change on portB0
+#define BATCHING_FLAG 0b10 // send 1 batched message for all pins changed at once
+#define GESTURES_FLAG 0b100 // recognize double and long presses
+#define CONFIG_LISTEN_INTERVAL_SHIFT 8 // bits 8-13 = heartbeats between listen windows (0 = CONFIG_LISTEN_DEFAULT_INTERVAL)
 
 /** 
  * These should be constants really (written and read from EEPROM)
@@ -37,18 +55,16 @@ boolean DEBUG = FALSE;
 boolean suppressSwitch = FALSE;
 int tHeartbeatTimeout = 10; // 10seconds default
 byte nodeID = 0; // is mandated to be non-zero, checked in initConfigData()
+unsigned int bitRate = DEFAULT_BIT_RATE; // speed in kbps
 
 /**
  * These are control variables used by the main loop
  */
 
-/** was the switch pressed? */
-volatile boolean switchPressed = FALSE;
-
 /** counter for pressing the switch */
 volatile unsigned long switchCounter = 0;
 
-/** current status of PORTB pins detected during the interrupt routine */
+/** last status of PORTB pins 4-7 detected during the interrupt routine (1 = input on), pins 0-3 are edge triggered and so do not need it */
 volatile byte portbStatus = 0;
 
 /** 
@@ -61,22 +77,55 @@ volatile unsigned long tLastSwitchQuarterSec = 0;
 
 /** timer data */
 volatile boolean timerElapsed = FALSE;
+volatile byte tTicksSinceStart = 0; // ticks of the input gestures timebase, see inputGestures.h
 volatile unsigned long tQuarterSecSinceStart = 0;
-volatile unsigned long tSecsSinceHeartbeat = 0;
 
 /** config data - if a config CAN message was sent */
 volatile unsigned int receivedConfigData = 0;
 
+/** action config data - if a config CAN message with an action was sent (0 length = nothing received). First byte plus 2 bytes per target at most */
+#define ACTION_CONFIG_LENGTH (1 + ACTION_SIZE)
+volatile byte receivedAction[ACTION_CONFIG_LENGTH];
+volatile byte receivedActionLength = 0;
+
+/** new bit rate received in a network command (0 = nothing received) */
+volatile unsigned int receivedBitRate = 0;
+/** SYNC network command received, the heartbeat period is restarted in the main loop */
+volatile boolean receivedSync = FALSE;
+
 /** a flag indicating whether change on portB0 should be treated as a special operation sending off for all floors  */
 boolean sendOffOnPortB0Change = FALSE;
 
+/** a flag indicating whether changes of more pins at once should be sent in 1 batched message (nodeID of the first pin and mask of all pins changed) */
+boolean batchPinChanges = FALSE;
+
+/** pins of single presses collected for the batched message */
+byte singlePressPins = 0;
+
+/** last tick of the timebase processed by the main loop */
+byte tLastTick = 0;
+
+/** TRUE once the node is configured and running - wake ups by the watchdog are only enabled then */
+boolean configured = FALSE;
+
+/** TRUE if CAN and transceiver are on (only ever FALSE in non DEBUG mode) */
+boolean canAwake = TRUE;
+
+/** ticks left to listen for CONFIG messages (CAN kept on) */
+byte configListenTicks = 0;
+
+/** heartbeats between listen windows and heartbeats sent since the last one */
+byte configListenInterval = CONFIG_LISTEN_DEFAULT_INTERVAL;
+byte heartbeatsSinceListen = 0;
+
 /*
  * Setup section
  */
 
 void configureSpeed() {
     // setup external oscillator - use default primary oscillator = as defined by config.h (last 2 bits)
-    OSCCON = 0;
+    // internal oscillator set to 16MHz, used to run right after wake up till the external oscillator is stable (two speed start up, see IESO in config.h)
+    OSCCON = 0b01110000;
     
     // enable ultra low power regulator in sleep, see also RETEN in config.h
     WDTCONbits.SRETEN = 1; 
@@ -138,10 +187,10 @@ void configureInput() {
 
 void configureTimer() {
     if (DEBUG) {
-        // enable timer, internal clock, use prescaler 1:16 (last 3 bits below)
-        // so we have 2^16 * 16 = 1mil oscillator cycles. Since 4 oscillator cycles made up 1 instruction cycle,
-        // we have 4mil oscillator cycles each second, so we should see an interrupt 4 times a second
-        T0CON = 0b10000011;
+        // enable timer, internal clock, use prescaler 1:4 (last 3 bits below)
+        // so we have 2^16 * 4 = 262144 instruction cycles. Since 4 oscillator cycles made up 1 instruction cycle,
+        // we have 4mil instruction cycles each second, so we should see an interrupt 16 times a second (1 tick of input gestures)
+        T0CON = 0b10000001;
         // enable timer interrupts
         INTCONbits.TMR0IE = 1;
     }
@@ -158,73 +207,142 @@ void configureInterrupts() {
     configureTimer();
 }
 
+void setupNetworkFilter() {
+    // standard ID: SIDH holds bits 10..3, SIDL bits 2..0 in its top 3 bits. EXIDEN bit clear in the filters to only match standard IDs
+    unsigned int id = (HEARTBEAT << 8) | NETWORK_NODE_ID;
+    byte sidh = (id >> 3) & MAX_8_BITS;
+    byte sidl = (id & 0b111) << 5;
+    RXM1SIDH = MAX_8_BITS;
+    RXM1SIDL = 0b11101000;
+    RXF2SIDH = sidh;
+    RXF2SIDL = sidl;
+    RXF3SIDH = sidh;
+    RXF3SIDL = sidl;
+    RXF4SIDH = sidh;
+    RXF4SIDL = sidl;
+    RXF5SIDH = sidh;
+    RXF5SIDL = sidl;
+    PIE5bits.RXB1IE = 1;
+}
+
 void configureCan() {
     can_initRcPortsForCan();
     
     // first move to CONFIG mode
     can_setMode(CONFIG_MODE);
 
-    can_setupBaudRate(BAUD_RATE, CPU_SPEED);
+    setupBitTiming(bitRate);
+    // no wake up by bus activity while CAN sleeps, with heartbeats of all switches on the bus it would keep us awake far too often
+    BRGCON3bits.WAKDIS = 1;
     
     // now setup CAN to receive only CONFIG message types for this node ID
-    if (DEBUG) {
-        CanHeader header;
-        header.nodeID = nodeID;
-        header.messageType = CONFIG;
-        can_setupStrictReceiveFilter(&header);
-    }
+    CanHeader header;
+    header.nodeID = nodeID;
+    header.messageType = CONFIG;
+    can_setupStrictReceiveFilter(&header);
+
+    // and network commands using receive buffer 1 - strict mask 1 and all its filters set to the same network command ID
+    setupNetworkFilter();
     // switch CAN to normal mode (using real underlying CAN)
     can_setMode(NORMAL_MODE);
     
-    // now enable CAN interrupts (only in debug mode, otherwise not needed and not used, just unnecessary load)
-    if (DEBUG) {
-        PIE5bits.ERRIE = 1;  // Enable CAN BUS error interrupt
-        PIE5bits.TXB0IE = 1; // Enable Transmit Buffer 0 Interrupt        
-    }
+    // transmit and error interrupts are needed always to wake the device up once messages are sent or the CAN module goes bus-off
+    initTransmit();
 }
 
 void configure() {
     configureSpeed();
     configureInterrupts();
     configureCan();
+    initWakeLatency();
 }
 
 /*
  * Input and timer processing
  */
 
+void inputChanged(byte pin, InputEdge edge) {
+    if (edge == PRESSED) {
+        switchCounter++;
+    }
+    // ticks idled while waiting for messages to get sent are only counted afterwards in non DEBUG mode, but they passed already
+    pushInputEvent(pin, edge, tTicksSinceStart + (DEBUG ? 0 : getIdledTicks()));
+}
+
+/**
+ * Processes an edge on one of the external interrupt pins (B0:B3). The edge of the interrupt is flipped each time so that both press and release are seen
+ * 
+ * @param pin pin the edge was detected on
+ * @param risingEdge edge the interrupt was set up for
+ * @return edge to set up the interrupt for next
+ */
+boolean edgeInputChanged(byte pin, boolean risingEdge) {
+    InputEdge edge = risingEdge ? RELEASED : PRESSED;
+    inputChanged(pin, edge);
+    
+    // the pin may have changed back already before we got here (e.g. very short press), report that edge right away since it would be missed otherwise
+    boolean pinHigh = (PORTB & (1 << pin)) ? TRUE : FALSE;
+    if (pinHigh == risingEdge) {
+        return !risingEdge;
+    }
+    inputChanged(pin, risingEdge ? PRESSED : RELEASED);
+    return risingEdge;
+}
+
 void checkInputChanged() {
     // check if external input change is enabled and interrupt flag set (B0:B3)
+    // the flag has to be cleared after the edge is changed, since changing the edge can set it too
+    if (INTCONbits.INT0IE && INTCONbits.INT0IF) {
+        INTCON2bits.INTEDG0 = edgeInputChanged(0, INTCON2bits.INTEDG0);
+        INTCONbits.INT0IF = 0;
+    }
+    if (INTCON3bits.INT1IE && INTCON3bits.INT1IF) {
+        INTCON2bits.INTEDG1 = edgeInputChanged(1, INTCON2bits.INTEDG1);
+        INTCON3bits.INT1IF = 0;
+    }
+    if (INTCON3bits.INT2IE && INTCON3bits.INT2IF) {
+        INTCON2bits.INTEDG2 = edgeInputChanged(2, INTCON2bits.INTEDG2);
+        INTCON3bits.INT2IF = 0;
+    }
+    if (INTCON3bits.INT3IE && INTCON3bits.INT3IF) {
+        INTCON2bits.INTEDG3 = edgeInputChanged(3, INTCON2bits.INTEDG3);
+        INTCON3bits.INT3IF = 0;
+    }
+    
     // check if input on change is enabled and interrupt flag set (B4:B7)
-    if ( (INTCONbits.INT0IE && INTCONbits.INT0IF) || (INTCON3bits.INT1IE && INTCON3bits.INT1IF) ||
-         (INTCON3bits.INT2IE && INTCON3bits.INT2IF) || (INTCON3bits.INT3IE && INTCON3bits.INT3IF) || 
-         (INTCONbits.RBIE && INTCONbits.RBIF) ) {
-        // read PORTB as mandated in datasheet to clear the input change mismatch - this would also be used by main thread to send respective CAN message
-        // reverse it first so that the main routine can rely on 1 meaning the respective input is ON
-        portbStatus = ~PORTB;
-
-        // at least s1 instruction cycle after read is mandated in datasheet to properly clear the interrupt on input!
-
-        // change the flag to let the main thread handle input change
-        switchPressed = TRUE;
-        switchCounter++;
+    if (INTCONbits.RBIE && INTCONbits.RBIF) {
+        // read PORTB as mandated in datasheet to clear the input change mismatch
+        // reverse it first so that 1 means the respective input is ON
+        byte status = ~PORTB & 0b11110000;
+        byte changed = status ^ portbStatus;
+        portbStatus = status;
         
-        // apart from clearing the interrupts, also disabled them - main thread should enable it again later
-        // should help with sporadic triggers from multiple inputs at the same time
-        di();
-        clearInterruptFlags();
+        // at least 1 instruction cycle after read is mandated in datasheet to properly clear the interrupt on input!
+        for (byte i=4; i<8; i++) {
+            if (changed & (1 << i)) {
+                inputChanged(i, (status & (1 << i)) ? PRESSED : RELEASED);
+            }
+        }
+        INTCONbits.RBIF = 0;
     }
 }
 
-void updateTick() {
-    if ( (++tQuarterSecSinceStart) % 4 == 0) { // we can safely let this go infinitely - would turn to 0 after max unsigned long
-        tSecsSinceHeartbeat ++;
+/**
+ * Counts one tick of the timebase
+ * 
+ * @return TRUE if another quarter of a second passed
+ */
+boolean updateTick() {
+    if ( (++tTicksSinceStart) % TICKS_PER_QUARTER_SEC) {
+        return FALSE;
     }
+    tQuarterSecSinceStart++; // we can safely let this go infinitely - would turn to 0 after max unsigned long
+    return TRUE;
 }
 
 void checkHeartBeat() {
-    if (tSecsSinceHeartbeat >= tHeartbeatTimeout) {
-        tSecsSinceHeartbeat = 0;
+    // the scheduler decides when exactly within the heartbeat timeout, see heartbeatScheduler.h
+    if (heartbeatTick()) {
         timerElapsed = TRUE;
     }    
 }
@@ -279,9 +397,10 @@ void checkStatus() {
 void checkTimerExpired() {
     // check if timer 0 interrupt is enabled and interrupt flag set
     if (INTCONbits.TMR0IE && INTCONbits.TMR0IF) {
-        updateTick();
-        checkHeartBeat();
-        checkStatus();
+        if (updateTick()) {
+            checkHeartBeat();
+            checkStatus();
+        }
         INTCONbits.TMR0IF = 0; // clear the interrupt
     }
 }
@@ -292,16 +411,35 @@ void checkCan() {
         // now confirm the buffer 0 is full and take directly 2 bytes of data from there - should be always present
         if (RXB0CONbits.RXFUL) {
             // we can only receive config messages, so no need to check what nodeID did we get
-            // form a 16bit int from the 2 incoming bytes and let the main thread process this message then (let the interrupt finish quickly)
-            receivedConfigData = (RXB0D0 << 8) + RXB0D1;
+            if (RXB0DLCbits.DLC % 2) {
+                // odd length = action config data, copy it all for the main thread (DLC can be up to 15, but the action is never longer)
+                byte dataLength = RXB0DLCbits.DLC;
+                if (dataLength > ACTION_CONFIG_LENGTH) {
+                    dataLength = ACTION_CONFIG_LENGTH;
+                }
+                volatile byte* data = &RXB0D0;
+                for (byte i=0; i<dataLength; i++) {
+                    receivedAction[i] = data[i];
+                }
+                receivedActionLength = dataLength;
+            } else {
+                // form a 16bit int from the 2 incoming bytes and let the main thread process this message then (let the interrupt finish quickly)
+                receivedConfigData = (RXB0D0 << 8) + RXB0D1;
+            }
             RXB0CONbits.RXFUL = 0; // mark the data in buffer as read and no longer needed
         }
         PIR5bits.RXB0IF = 0;
-    } else if (PIE5bits.TXB0IE && PIR5bits.TXB0IF) {
-        // Transmit Buffer 0 interrupt
-        // means the CAN send just finished OK
-        messageStatus.statusCode = OK;
-        PIR5bits.TXB0IF = 0;
+    } else if (PIE5bits.RXB1IE && PIR5bits.RXB1IF) {
+        // CAN receive buffer 1 interrupt - network commands only
+        if (RXB1CONbits.RXFUL) {
+            if (RXB1DLCbits.DLC == 3 && RXB1D0 == NETWORK_COMMAND_BIT_RATE) {
+                receivedBitRate = (RXB1D1 << 8) + RXB1D2;
+            } else if (RXB1D0 == NETWORK_COMMAND_SYNC) {
+                receivedSync = TRUE;
+            }
+            RXB1CONbits.RXFUL = 0;
+        }
+        PIR5bits.RXB1IF = 0;
     } else if (PIE5bits.ERRIE && PIR5bits.ERRIF) {
         // Can Module Error Interrupt
         // means some error in CAN happened
@@ -318,6 +456,8 @@ void interrupt handleInterrupt(void) {
     checkTimerExpired();
     checkInputChanged();
     checkCan();
+    checkTransmitCompleted();
+    checkDaoWriteCompleted();
 }
 
 /*
@@ -336,36 +476,65 @@ void switchTransceiverOff() {
     PORTCbits.RC3 = 1;
 }
 
-void sleepDevice() {
-    if (!DEBUG) {
-        // setup SLEEP mode of the CAN module to save power
-        can_setMode(SLEEP_MODE);
-        // apply high on standby pin of transceiver to put it into sleep and low power mode (15uA top from datasheet)
-        switchTransceiverOff();
-        // enter sleep mode now to be waken up by interrupt later, some other power saving settings also kick in now, for example ultra low power voltage regulator
-        Sleep();
+/**
+ * Switches CAN and the transceiver on if not on already. Called only right before sending or listening, so wake ups with nothing to send
+ * (e.g. watchdog ticks) never switch them on
+ */
+void wakeUpDevice() {
+    if (!DEBUG && !canAwake) {
+        // switch the transceiver on first thing, so that it starts up while the external oscillator and CAN module start up too
+        // right after wake up we still run from the internal oscillator
+        switchTransceiverOn();
+        unsigned int tTransceiverOn = getTimerTime();
+        // CAN needs the external oscillator for its bit timing, so wait for it to be stable
+        while (!OSCCONbits.OSTS);
+        can_setMode(NORMAL_MODE);
+
+        // we need to wait 50us since the transceiver was switched on since it could just be going back from standby
+        // datasheet says 40us max, we will be conservative and do 50us instead. Only wait for the time not passed yet
+        // (the timer as is, the time since wake saturates once out of range and would never move on)
+        while (getTimerTime() - tTransceiverOn < TRANSCEIVER_WAKE_US);
+        canAwake = TRUE;
     }
 }
 
 /**
- * Do NOP for in passed umber of microsends. Can be used to actively delay processing instructions, e.g. when waiting for the transceiver to start up.
- * @param micros number of microsends to do NOP for
+ * Processes 1 tick of the watchdog in non DEBUG mode (the same as timer 0 does in DEBUG mode)
  */
-void nopMicrosends (int micros) {
-    // our speed is in MHz, in other words we can do CPU_SPEED instructions in 1 micro second
-    for (int i=0; i<CPU_SPEED * micros; i++) {
-        NOP();
+void watchdogTick() {
+    if (updateTick()) {
+        checkHeartBeat();
+    }
+    if (configListenTicks) {
+        configListenTicks--;
     }
 }
 
-void wakeUpDevice() {
+void sleepDevice() {
     if (!DEBUG) {
-        switchTransceiverOn();
-        can_setMode(NORMAL_MODE);
-
-        // we need to wait 50us now since the transceiver could just be going back from standby
-        // datasheet says 40us max, we will be conservative and do 50us instead
-        nopMicrosends(50);
+        if (configListenTicks) {
+            // listening for CONFIG messages - CAN has to stay on, so only idle (the clock keeps running), a message received wakes the device up
+            wakeUpDevice();
+            OSCCONbits.IDLEN = 1;
+        } else {
+            // setup SLEEP mode of the CAN module to save power
+            can_setMode(SLEEP_MODE);
+            // apply high on standby pin of transceiver to put it into sleep and low power mode (15uA top from datasheet)
+            switchTransceiverOff();
+            canAwake = FALSE;
+        }
+        // heartbeats and input gestures need the timebase, so let the watchdog wake the device up after 1 tick
+        // clear it first, so that the time-out bit below is never left over from an earlier wake up (Sleep does not idle with an interrupt flag pending)
+        CLRWDT();
+        WDTCONbits.SWDTEN = configured;
+        // enter sleep mode now to be waken up by interrupt later, some other power saving settings also kick in now, for example ultra low power voltage regulator
+        Sleep();
+        WDTCONbits.SWDTEN = 0;
+        OSCCONbits.IDLEN = 0;
+        // time-out bit cleared means the watchdog woke us up, i.e. 1 tick passed
+        if (!RCONbits.TO) {
+            watchdogTick();
+        }
     }
 }
 
@@ -386,6 +555,7 @@ void updateConfigData(DataItem *dataItem) {
         switch (dataItem->bucket) {
             case HEARTBEAT_TIMEOUT_DAO_BUCKET:
                 tHeartbeatTimeout = dataItem->value;
+                setupHeartbeat(nodeID, tHeartbeatTimeout);
                 break;
             case SUPPRESS_SWITCH_DAO_BUCKET:
                 suppressSwitch = (dataItem->value > 0);
@@ -394,9 +564,16 @@ void updateConfigData(DataItem *dataItem) {
                 nodeID = dataItem->value;
                 // in this case we also need to configure again to change CAN acceptance filters, etc
                 configure();
+                setupHeartbeat(nodeID, tHeartbeatTimeout);
                 break;
             case OFF_ALL_FLAG_DAO_BUCKET:
-                sendOffOnPortB0Change = (dataItem->value > 0);
+                sendOffOnPortB0Change = (dataItem->value & OFF_ALL_FLAG) ? TRUE : FALSE;
+                batchPinChanges = (dataItem->value & BATCHING_FLAG) ? TRUE : FALSE;
+                setGesturesEnabled((dataItem->value & GESTURES_FLAG) ? TRUE : FALSE);
+                configListenInterval = (dataItem->value >> CONFIG_LISTEN_INTERVAL_SHIFT) & 0b111111;
+                if (!configListenInterval) {
+                    configListenInterval = CONFIG_LISTEN_DEFAULT_INTERVAL;
+                }
                 break;
         }
     }
@@ -407,6 +584,9 @@ void updateConfigData(DataItem *dataItem) {
  * @return TRUE if all mandatory values were read OK, false otherwise
  */
 boolean initConfigData() {
+    // bit rate falls back to the default if not set
+    bitRate = loadBitRate();
+    
     // try nodeID, which is mandatory. If it is not set, then nothing to be done here, so just sleep the device
     DataItem dataItem = dao_loadDataItem(NODE_ID_DAO_BUCKET);
     if (!isValidDataItem(&dataItem)) {
@@ -414,11 +594,6 @@ boolean initConfigData() {
     }
     updateConfigData (&dataItem);
     
-    // now also use the nodeID as the number of seconds already passed from the timer
-    // helps avoiding burst of heartbeat messages from all can switches on the network at the same time
-    // they should evenly split by a second as a result of this
-    tSecsSinceHeartbeat = nodeID;
-    
     // other attributes are not mandatory
     
     dataItem = dao_loadDataItem(HEARTBEAT_TIMEOUT_DAO_BUCKET);
@@ -430,12 +605,26 @@ boolean initConfigData() {
     
     dataItem = dao_loadDataItem(OFF_ALL_FLAG_DAO_BUCKET);
     updateConfigData (&dataItem);
+    
+    // heartbeat slot is derived from the nodeID, helps avoiding burst of heartbeat messages from all can switches on the network at the same time
+    setupHeartbeat(nodeID, tHeartbeatTimeout);
+    
+    initActions();
 
     return TRUE;
 }
 
-void sendCanMessage(MessageType messageType, byte nodeID, Operation operation) {
+/**
+ * Sends 1 CAN message
+ * 
+ * @param messageType message type to send over
+ * @param nodeID nodeID to send
+ * @param operation operation to send
+ * @param batchedPins mask of other pins changed following the pin of the nodeID (bit 0 = nodeID + 1) for a batched NORMAL message, 0 otherwise
+ */
+void sendCanMessage(MessageType messageType, byte nodeID, Operation operation, byte batchedPins) {
     messageStatus.timestamp = tQuarterSecSinceStart;
+    messageStatus.statusCode = SENDING;
     
     CanHeader header;
     header.nodeID = nodeID;
@@ -445,7 +634,11 @@ void sendCanMessage(MessageType messageType, byte nodeID, Operation operation) {
     message.header = &header;
     
     // data length - equal to 6 for heartbeat and 1 for normal messages
-    message.dataLength = (messageType == HEARTBEAT) ? 6:1;
+    message.dataLength = (messageType == HEARTBEAT) ? HEARTBEAT_LENGTH:1;
+    // batched message has 1 more byte - the mask of pins
+    if (batchedPins) {
+        message.dataLength = 2;
+    }
 
     // data - set operation to be toggle, pass in the other args too to combine first byte all the time
     byte* data = &message.data;
@@ -462,12 +655,67 @@ void sendCanMessage(MessageType messageType, byte nodeID, Operation operation) {
         *data++ = RXERRCNT;
         // another byte = firmware version
         *data++ = FIRMWARE_VERSION;
-        // last 2 bytes = time since start. Ignore any values higher, only used in debugging anyway
+        // next 2 bytes = time since start. Ignore any values higher, only used in debugging anyway
         *data++ = (timeSinceStart >> 8) & MAX_8_BITS;
         *data++ = timeSinceStart & MAX_8_BITS;
+    } else if (batchedPins) {
+        *data++ = batchedPins;
+    }
+    // measure the time from wake up to the press being sent
+    if (messageType == NORMAL) {
+        latencyTransmitRequested();
     }
-    // use the synchronous version to make sure the message is really sent before moving on
-    can_sendSynchronous(&message);
+    wakeUpDevice();
+    // do not wait for the message to get sent, more messages can go out back to back this way (see switchTransmit.h)
+    transmit(&message);
+}
+
+/**
+ * Sends the counters of things dropped as another heartbeat message with 3 bytes of data (the data length tells the heartbeat messages apart):
+ * messages dropped and bus-off states seen since start (see switchTransmit.h) and input changes dropped since start (see inputEvents.h), capped at 1 byte each
+ */
+void sendDropDiagnostics() {
+    CanHeader header;
+    header.nodeID = nodeID;
+    header.messageType = HEARTBEAT;
+    
+    CanMessage message;
+    message.header = &header;
+    message.dataLength = DROP_DIAGNOSTICS_LENGTH;
+    
+    unsigned int transmitDrops = getTransmitDrops();
+    unsigned int busOffs = getBusOffs();
+    unsigned int inputEventOverflows = getInputEventOverflows();
+    byte* data = &message.data;
+    *data++ = (transmitDrops > MAX_8_BITS) ? MAX_8_BITS : transmitDrops;
+    *data++ = (busOffs > MAX_8_BITS) ? MAX_8_BITS : busOffs;
+    *data++ = (inputEventOverflows > MAX_8_BITS) ? MAX_8_BITS : inputEventOverflows;
+    wakeUpDevice();
+    transmit(&message);
+}
+
+/**
+ * Sends the wake latencies measured (see wakeLatency.h) as another heartbeat message with all 8 bytes of data: 
+ * last wake up to first message requested, last wake up to all messages sent, min and max of the latter (2 bytes each, in us)
+ */
+void sendLatencyDiagnostics() {
+    CanHeader header;
+    header.nodeID = nodeID;
+    header.messageType = HEARTBEAT;
+    
+    CanMessage message;
+    message.header = &header;
+    message.dataLength = LATENCY_DIAGNOSTICS_LENGTH;
+    
+    WakeLatency* wakeLatency = getWakeLatency();
+    unsigned int latencies[4] = { wakeLatency->lastRequest, wakeLatency->lastComplete, wakeLatency->minComplete, wakeLatency->maxComplete };
+    byte* data = &message.data;
+    for (byte i=0; i<4; i++) {
+        *data++ = (latencies[i] >> 8) & MAX_8_BITS;
+        *data++ = latencies[i] & MAX_8_BITS;
+    }
+    wakeUpDevice();
+    transmit(&message);
 }
 
 /**
@@ -480,20 +728,130 @@ void sendCanMessages(MessageType messageType, byte portBPin) {
     if (sendOffOnPortB0Change && messageType == NORMAL && portBPin == 0) {
         // if sendOffOnPortB0Change is set and NORMAL message for portb 0 should be sent, then send 2 CAN messages
         // send operation OFF for both floors in that case
-        sendCanMessage(messageType, GROUND, OFF);
-        sendCanMessage(messageType, FIRST, OFF);
+        sendCanMessage(messageType, GROUND, OFF, 0);
+        sendCanMessage(messageType, FIRST, OFF, 0);
     } else {
         // for all other cases, simply send nodeID + port B pin changed as nodeID and toggle as operation
         // for B0 directly nodeID is sent, up to nodeId+7 depending on which pin was set
-        sendCanMessage(messageType, nodeID + portBPin, TOGGLE);
+        sendCanMessage(messageType, nodeID + portBPin, TOGGLE, 0);
     }
 }
 
-void switchPressProcessed() {
-    switchPressed = FALSE;
-    // just in case clear any potential input interrupts and enable interrupts again
-    clearInterruptFlags();
-    ei();
+/**
+ * Sends 1 batched NORMAL message for all the pins changed (except for portB0 if that is to send OFF messages, that one is sent separately)
+ * 
+ * @param pins mask of all portB pins changed
+ */
+void sendBatchedCanMessages(byte pins) {
+    if (sendOffOnPortB0Change && (pins & 1)) {
+        sendCanMessages(NORMAL, 0);
+        pins &= ~1;
+    }
+    if (!pins) {
+        return;
+    }
+    
+    // nodeID of the first pin changed, the mask then covers the pins following that one
+    byte firstPin = 0;
+    while (!(pins & (1 << firstPin))) {
+        firstPin++;
+    }
+    byte batchedPins = pins >> (firstPin + 1);
+    
+    if (!batchedPins) {
+        // just 1 pin, so the usual message
+        sendCanMessages(NORMAL, firstPin);
+    } else {
+        sendCanMessage(NORMAL, nodeID + firstPin, TOGGLE, batchedPins);
+    }
+}
+
+/**
+ * Sends the CAN messages for a gesture recognized on a pin. If an action is set for the pin and gesture, a message is sent to each target of the action.
+ * Otherwise the default applies: single press toggles nodeID of the pin (as sent always before gestures were introduced), long press switches it on
+ * and double press applies the scene of the pin number on the floor of this switch
+ * 
+ * In the batching mode, single presses without an action are collected into 1 batched message until the same pin is pressed again
+ * 
+ * @param pin pin of the gesture
+ * @param gesture gesture recognized
+ */
+void processGesture(byte pin, Gesture gesture) {
+    if (gesture == NO_GESTURE || suppressSwitch) {
+        return;
+    }
+    
+    Action* action = getAction(pin, gesture);
+    if (action) {
+        ActionTarget* target = action->targets;
+        for (byte i=0; i<ACTION_TARGETS; i++, target++) {
+            if (target->operation <= OFF) {
+                sendCanMessage(NORMAL, target->nodeID, target->operation, 0);
+            }
+        }
+        return;
+    }
+    
+    switch (gesture) {
+        case SINGLE_PRESS:
+            if (!batchPinChanges) {
+                sendCanMessages(NORMAL, pin);
+            } else {
+                if (singlePressPins & (1 << pin)) {
+                    // pressed again, so send what we have so far first
+                    sendBatchedCanMessages(singlePressPins);
+                    singlePressPins = 0;
+                }
+                singlePressPins |= 1 << pin;
+            }
+            break;
+        case LONG_PRESS:
+            sendCanMessage(NORMAL, nodeID + pin, ON, 0);
+            break;
+        case DOUBLE_PRESS:
+            sendCanMessage(NORMAL, (nodeID & FIRST) + SCENE_NODEID_OFFSET + pin, ON, 0);
+            break;
+    }
+}
+
+/**
+ * Processes the next tick of the timebase not processed yet for all inputs
+ */
+void processTick() {
+    tLastTick++;
+    // reverse so that 1 means the respective input is on
+    byte status = ~PORTB;
+    for (byte i=0; i<INPUTS_COUNT; i++) {
+        processGesture(i, inputTick(i, (status & (1 << i)) ? TRUE : FALSE));
+    }
+}
+
+/**
+ * Drains all input events detected so far and processes the edges in the order detected, each after the ticks of the timebase passed before it,
+ * so that debouncing and gestures see the edges at the time they were detected even if they waited in the queue (e.g. while sending).
+ * A CAN message is then sent for each gesture recognized
+ */
+void processInputEvents() {
+    InputEvent* inputEvent;
+    while ( (inputEvent = peekInputEvent()) ) {
+        // never beyond the ticks passed so far (the tick of the event wraps around after 16s)
+        while (tLastTick != inputEvent->tick && tLastTick != tTicksSinceStart) {
+            processTick();
+        }
+        byte pin = inputEvent->pin;
+        Gesture gesture = inputEdge(pin, inputEvent->edge);
+        popInputEvent();
+        processGesture(pin, gesture);
+    }
+    
+    while (tLastTick != tTicksSinceStart) {
+        processTick();
+    }
+    
+    if (singlePressPins) {
+        sendBatchedCanMessages(singlePressPins);
+        singlePressPins = 0;
+    }
 }
 
 /**
@@ -508,25 +866,23 @@ int main(void) {
     
     // all OK, so start up
     configure();
+    configured = TRUE;
     
     while (TRUE) {
-        wakeUpDevice();
-        if (switchPressed) {
-            // dropped condition for time check since that would require a timer
-            if (!suppressSwitch) {
-                // now loop through all PORTB pins as were set in interrupt routine and for all low (could be multiple), send a CAN message out
-                // we have 1s there where the input is on right now (weak pull ups but reverted in portbChanged function)
-                for (int i=0; i<8; i++) {
-                    if (portbStatus & (1 << i)) {
-                        sendCanMessages(NORMAL, i);
-                    }
-                }
-            }
-            switchPressProcessed();
-        }
+        // CAN and the transceiver are only switched on when needed, but measure from the wake up
+        latencyWake();
+        // send all gestures of the input changes detected by the interrupt so far, the interrupt keeps queueing new ones meanwhile
+        processInputEvents();
         if (timerElapsed) {
             sendCanMessages(HEARTBEAT, 0);
+            sendDropDiagnostics();
+            sendLatencyDiagnostics();
             timerElapsed = FALSE;
+            // every few heartbeats listen for CONFIG messages for a while, so that the gateway can answer the heartbeat with them
+            if (++heartbeatsSinceListen >= configListenInterval) {
+                heartbeatsSinceListen = 0;
+                configListenTicks = CONFIG_LISTEN_TICKS;
+            }
         }
         if (receivedConfigData) {
             // first 2 bits = bucket in DAO, the other 14 bits = data itself
@@ -534,11 +890,73 @@ int main(void) {
             dataItem.bucket = (receivedConfigData >> 14);
             dataItem.value = MAX_14_BITS & receivedConfigData;
             
-            dao_saveDataItem(&dataItem);
+            queueDataItem(&dataItem);
             updateConfigData(&dataItem);
             receivedConfigData = 0;
+            // keep listening, more CONFIG messages are likely to follow
+            configListenTicks = CONFIG_LISTEN_TICKS;
+        }
+        if (receivedActionLength) {
+            // take a copy first, the interrupt could overwrite the action with the next message received meanwhile
+            byte action[ACTION_CONFIG_LENGTH];
+            di();
+            byte actionLength = receivedActionLength;
+            for (byte i=0; i<actionLength; i++) {
+                action[i] = receivedAction[i];
+            }
+            receivedActionLength = 0;
+            ei();
+            
+            // first byte = pin in the upper 4 bits and gesture in the lower 4 bits, then nodeID and operation of each target
+            updateAction(action[0] >> 4, action[0] & 0b1111, action + 1, actionLength / 2);
+            configListenTicks = CONFIG_LISTEN_TICKS;
+        }
+        if (receivedBitRate) {
+            // used right away, all nodes received the same network command at the same time. Only on trial first though (see canNetwork.h)
+            if (startBitRateTrial(bitRate, receivedBitRate, tQuarterSecSinceStart)) {
+                bitRate = receivedBitRate;
+                configureCan();
+            }
+            receivedBitRate = 0;
+        }
+        if (receivedSync) {
+            // in DEBUG mode the heartbeat ticks come from the timer interrupt, so keep it out meanwhile
+            di();
+            syncHeartbeat();
+            receivedSync = FALSE;
+            ei();
+        }
+        // write next byte of config data into EEPROM, EEIF wakes the device up once the byte is written
+        processDaoQueue();
+        // CAN goes to sleep too, so all messages have to be sent first
+        waitTransmitted();
+        // heartbeats and input gestures keep their timing even if the wait took long (in DEBUG mode timer 0 kept ticking meanwhile)
+        // with interrupts disabled, so that input changes meanwhile are not timed before these ticks (see inputChanged)
+        di();
+        byte ticks = takeIdledTicks();
+        if (!DEBUG) {
+            while (ticks--) {
+                watchdogTick();
+            }
+        }
+        ei();
+        // back to the previous bit rate if the messages sent on the new one failed
+        unsigned int previousBitRate = checkBitRateTrial(tQuarterSecSinceStart);
+        if (previousBitRate) {
+            bitRate = previousBitRate;
+            configureCan();
+        }
+        // messages of other nodes sent at the same time, so the bus is busy
+        if (checkArbitrationLost()) {
+            heartbeatBusActivity();
+        }
+        // only sleep if no input changed meanwhile, otherwise it would only be sent on next wake up. Interrupts are disabled from the check till after
+        // the sleep, so that no input change can come in between. Its interrupt flag still wakes the device up and the interrupt is processed once enabled again
+        di();
+        if (!peekInputEvent()) {
+            sleepDevice(); // now need to loop infinitely, interrupt will wake the device up and continue from next instruction -i.e. start of this loop
         }
-        sleepDevice(); // now need to loop infinitely, interrupt will wake the device up and continue from next instruction -i.e. start of this loop
+        ei();
     }
     
     return 0;
@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=main.c ../../piclib/can.c ../../piclib/dao.c
+SOURCEFILES_QUOTED_IF_SPACED=main.c ../../piclib/can.c ../../piclib/dao.c ../CanSetup.X/daoQueue.c ../CanSetup.X/canNetwork.c inputEvents.c inputGestures.c switchTransmit.c switchActions.c wakeLatency.c heartbeatScheduler.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/main.p1 ${OBJECTDIR}/_ext/962885029/can.p1 ${OBJECTDIR}/_ext/962885029/dao.p1
-POSSIBLE_DEPFILES=${OBJECTDIR}/main.p1.d ${OBJECTDIR}/_ext/962885029/can.p1.d ${OBJECTDIR}/_ext/962885029/dao.p1.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/main.p1 ${OBJECTDIR}/_ext/962885029/can.p1 ${OBJECTDIR}/_ext/962885029/dao.p1 ${OBJECTDIR}/_ext/948908131/daoQueue.p1 ${OBJECTDIR}/_ext/948908131/canNetwork.p1 ${OBJECTDIR}/inputEvents.p1 ${OBJECTDIR}/inputGestures.p1 ${OBJECTDIR}/switchTransmit.p1 ${OBJECTDIR}/switchActions.p1 ${OBJECTDIR}/wakeLatency.p1 ${OBJECTDIR}/heartbeatScheduler.p1
+POSSIBLE_DEPFILES=${OBJECTDIR}/main.p1.d ${OBJECTDIR}/_ext/962885029/can.p1.d ${OBJECTDIR}/_ext/962885029/dao.p1.d ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d ${OBJECTDIR}/inputEvents.p1.d ${OBJECTDIR}/inputGestures.p1.d ${OBJECTDIR}/switchTransmit.p1.d ${OBJECTDIR}/switchActions.p1.d ${OBJECTDIR}/wakeLatency.p1.d ${OBJECTDIR}/heartbeatScheduler.p1.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/main.p1 ${OBJECTDIR}/_ext/962885029/can.p1 ${OBJECTDIR}/_ext/962885029/dao.p1
+OBJECTFILES=${OBJECTDIR}/main.p1 ${OBJECTDIR}/_ext/962885029/can.p1 ${OBJECTDIR}/_ext/962885029/dao.p1 ${OBJECTDIR}/_ext/948908131/daoQueue.p1 ${OBJECTDIR}/_ext/948908131/canNetwork.p1 ${OBJECTDIR}/inputEvents.p1 ${OBJECTDIR}/inputGestures.p1 ${OBJECTDIR}/switchTransmit.p1 ${OBJECTDIR}/switchActions.p1 ${OBJECTDIR}/wakeLatency.p1 ${OBJECTDIR}/heartbeatScheduler.p1
 
 # Source Files
-SOURCEFILES=main.c ../../piclib/can.c ../../piclib/dao.c
+SOURCEFILES=main.c ../../piclib/can.c ../../piclib/dao.c ../CanSetup.X/daoQueue.c ../CanSetup.X/canNetwork.c inputEvents.c inputGestures.c switchTransmit.c switchActions.c wakeLatency.c heartbeatScheduler.c
 
 
 CFLAGS=
@@ -101,6 +101,70 @@ ${OBJECTDIR}/main.p1: main.c  nbproject/Makefile-${CND_CONF}.mk
 	@-${MV} ${OBJECTDIR}/main.d ${OBJECTDIR}/main.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/main.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/heartbeatScheduler.p1: heartbeatScheduler.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/heartbeatScheduler.p1.d 
+	@${RM} ${OBJECTDIR}/heartbeatScheduler.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/heartbeatScheduler.p1 heartbeatScheduler.c 
+	@-${MV} ${OBJECTDIR}/heartbeatScheduler.d ${OBJECTDIR}/heartbeatScheduler.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/heartbeatScheduler.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/wakeLatency.p1: wakeLatency.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/wakeLatency.p1.d 
+	@${RM} ${OBJECTDIR}/wakeLatency.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/wakeLatency.p1 wakeLatency.c 
+	@-${MV} ${OBJECTDIR}/wakeLatency.d ${OBJECTDIR}/wakeLatency.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/wakeLatency.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/switchActions.p1: switchActions.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/switchActions.p1.d 
+	@${RM} ${OBJECTDIR}/switchActions.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/switchActions.p1 switchActions.c 
+	@-${MV} ${OBJECTDIR}/switchActions.d ${OBJECTDIR}/switchActions.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/switchActions.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/switchTransmit.p1: switchTransmit.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/switchTransmit.p1.d 
+	@${RM} ${OBJECTDIR}/switchTransmit.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/switchTransmit.p1 switchTransmit.c 
+	@-${MV} ${OBJECTDIR}/switchTransmit.d ${OBJECTDIR}/switchTransmit.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/switchTransmit.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/inputGestures.p1: inputGestures.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/inputGestures.p1.d 
+	@${RM} ${OBJECTDIR}/inputGestures.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/inputGestures.p1 inputGestures.c 
+	@-${MV} ${OBJECTDIR}/inputGestures.d ${OBJECTDIR}/inputGestures.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/inputGestures.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/inputEvents.p1: inputEvents.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/inputEvents.p1.d 
+	@${RM} ${OBJECTDIR}/inputEvents.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/inputEvents.p1 inputEvents.c 
+	@-${MV} ${OBJECTDIR}/inputEvents.d ${OBJECTDIR}/inputEvents.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/inputEvents.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/948908131/canNetwork.p1: ../CanSetup.X/canNetwork.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/948908131" 
+	@${RM} ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/948908131/canNetwork.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/_ext/948908131/canNetwork.p1 ../CanSetup.X/canNetwork.c 
+	@-${MV} ${OBJECTDIR}/_ext/948908131/canNetwork.d ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/948908131/daoQueue.p1: ../CanSetup.X/daoQueue.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/948908131" 
+	@${RM} ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/948908131/daoQueue.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1  --debugger=pickit3  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/_ext/948908131/daoQueue.p1 ../CanSetup.X/daoQueue.c 
+	@-${MV} ${OBJECTDIR}/_ext/948908131/daoQueue.d ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/_ext/962885029/can.p1: ../../piclib/can.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/962885029" 
 	@${RM} ${OBJECTDIR}/_ext/962885029/can.p1.d 
@@ -126,6 +190,70 @@ ${OBJECTDIR}/main.p1: main.c  nbproject/Makefile-${CND_CONF}.mk
 	@-${MV} ${OBJECTDIR}/main.d ${OBJECTDIR}/main.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/main.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/heartbeatScheduler.p1: heartbeatScheduler.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/heartbeatScheduler.p1.d 
+	@${RM} ${OBJECTDIR}/heartbeatScheduler.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/heartbeatScheduler.p1 heartbeatScheduler.c 
+	@-${MV} ${OBJECTDIR}/heartbeatScheduler.d ${OBJECTDIR}/heartbeatScheduler.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/heartbeatScheduler.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/wakeLatency.p1: wakeLatency.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/wakeLatency.p1.d 
+	@${RM} ${OBJECTDIR}/wakeLatency.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/wakeLatency.p1 wakeLatency.c 
+	@-${MV} ${OBJECTDIR}/wakeLatency.d ${OBJECTDIR}/wakeLatency.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/wakeLatency.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/switchActions.p1: switchActions.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/switchActions.p1.d 
+	@${RM} ${OBJECTDIR}/switchActions.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/switchActions.p1 switchActions.c 
+	@-${MV} ${OBJECTDIR}/switchActions.d ${OBJECTDIR}/switchActions.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/switchActions.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/switchTransmit.p1: switchTransmit.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/switchTransmit.p1.d 
+	@${RM} ${OBJECTDIR}/switchTransmit.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/switchTransmit.p1 switchTransmit.c 
+	@-${MV} ${OBJECTDIR}/switchTransmit.d ${OBJECTDIR}/switchTransmit.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/switchTransmit.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/inputGestures.p1: inputGestures.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/inputGestures.p1.d 
+	@${RM} ${OBJECTDIR}/inputGestures.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/inputGestures.p1 inputGestures.c 
+	@-${MV} ${OBJECTDIR}/inputGestures.d ${OBJECTDIR}/inputGestures.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/inputGestures.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/inputEvents.p1: inputEvents.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/inputEvents.p1.d 
+	@${RM} ${OBJECTDIR}/inputEvents.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/inputEvents.p1 inputEvents.c 
+	@-${MV} ${OBJECTDIR}/inputEvents.d ${OBJECTDIR}/inputEvents.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/inputEvents.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/948908131/canNetwork.p1: ../CanSetup.X/canNetwork.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/948908131" 
+	@${RM} ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/948908131/canNetwork.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/_ext/948908131/canNetwork.p1 ../CanSetup.X/canNetwork.c 
+	@-${MV} ${OBJECTDIR}/_ext/948908131/canNetwork.d ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/948908131/canNetwork.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/948908131/daoQueue.p1: ../CanSetup.X/daoQueue.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/948908131" 
+	@${RM} ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/948908131/daoQueue.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=-asm,-asmfile,-speed,+space,-debug,-local --addrqual=require --mode=free -P -N255 -I"../../piclib" -I"../CanSetup.X" --warn=0 --asmlist -DXPRJ_default=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     -o${OBJECTDIR}/_ext/948908131/daoQueue.p1 ../CanSetup.X/daoQueue.c 
+	@-${MV} ${OBJECTDIR}/_ext/948908131/daoQueue.d ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/948908131/daoQueue.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/_ext/962885029/can.p1: ../../piclib/can.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/962885029" 
 	@${RM} ${OBJECTDIR}/_ext/962885029/can.p1.d 
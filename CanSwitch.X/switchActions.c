@@ -0,0 +1,59 @@
+/* 
+ * Switch actions implementation - the whole table is kept in RAM, read in one go on startup
+ * 
+ * File:   switchActions.c
+ * Author: pojd
+ *
+ * Created on December 22, 2018, 7:30 PM
+ */
+
+#include "switchActions.h"
+
+Action actions[INPUTS_COUNT][ACTION_GESTURES];
+
+/*
+ * Private methods
+ */
+
+boolean isValidGesture(Gesture gesture) {
+    return (gesture >= SINGLE_PRESS && gesture <= LONG_PRESS);
+}
+
+/*
+ * API methods
+ */
+
+void initActions() {
+    readEeprom(ACTIONS_ADDRESS, (byte*) actions, ACTIONS_END_ADDRESS - ACTIONS_ADDRESS);
+}
+
+Action* getAction(byte pin, Gesture gesture) {
+    if (pin >= INPUTS_COUNT || !isValidGesture(gesture)) {
+        return NULL;
+    }
+    
+    Action* action = &actions[pin][gesture - SINGLE_PRESS];
+    // only operations TOGGLE, ON and OFF make sense to be sent, anything else (e.g. EEPROM never written) means no action
+    return (action->targets[0].operation <= OFF) ? action : NULL;
+}
+
+void updateAction(byte pin, Gesture gesture, byte* targets, byte targetsCount) {
+    if (pin >= INPUTS_COUNT || !isValidGesture(gesture)) {
+        return;
+    }
+    
+    byte actionIndex = pin * ACTION_GESTURES + gesture - SINGLE_PRESS;
+    unsigned int address = ACTIONS_ADDRESS + actionIndex * ACTION_SIZE;
+    ActionTarget* target = actions[pin][gesture - SINGLE_PRESS].targets;
+    for (byte i=0; i<ACTION_TARGETS; i++, target++) {
+        if (i < targetsCount) {
+            target->nodeID = *targets++;
+            target->operation = *targets++;
+        } else {
+            target->nodeID = NO_TARGET;
+            target->operation = NO_TARGET;
+        }
+        queueEepromWord(address, (target->nodeID << 8) | target->operation);
+        address += 2;
+    }
+}
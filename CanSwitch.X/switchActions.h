@@ -0,0 +1,87 @@
+/* 
+ * Switch actions is a table of actions to perform for each input and gesture (see inputGestures.h), stored in EEPROM and set up at runtime using CONFIG messages.
+ * 
+ * Each action has up to ACTION_TARGETS targets, each target is a nodeID (of a light, the whole floor or a scene) and the operation to send to it.
+ * An input and gesture without any action set keeps the default behavior of the switch (e.g. toggle nodeID + pin on single press).
+ * 
+ * File:   switchActions.h
+ * Author: pojd
+ *
+ * Created on December 22, 2018, 7:12 PM
+ */
+
+#ifndef SWITCHACTIONS_H
+#define	SWITCHACTIONS_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include "utils.h"
+#include "can.h"
+#include "daoQueue.h"
+#include "inputGestures.h"
+
+// max number of targets of 1 action (1 message per target, all sent back to back using all transmit buffers)
+#define ACTION_TARGETS 3
+// gestures having an action (all but NO_GESTURE)
+#define ACTION_GESTURES 3
+// operation of a target not used (the same as EEPROM never written)
+#define NO_TARGET MAX_8_BITS
+
+/**
+ * Action table is stored right after the DAO buckets, actions of all gestures of input 0 first, then input 1, etc. Each target takes 2 bytes: nodeID and operation
+ */
+#define ACTIONS_ADDRESS EEPROM_FREE_ADDRESS
+#define ACTION_SIZE (2 * ACTION_TARGETS)
+#define ACTIONS_END_ADDRESS (ACTIONS_ADDRESS + INPUTS_COUNT * ACTION_GESTURES * ACTION_SIZE)
+
+/**
+ * One target of an action
+ */
+typedef struct {
+    byte nodeID; // nodeID to send the message to
+    byte operation; // operation to send, NO_TARGET if the target is not used
+} ActionTarget;
+
+/**
+ * Action - all targets to send messages to
+ */
+typedef struct {
+    ActionTarget targets[ACTION_TARGETS];
+} Action;
+
+/**
+ * Operations
+ */
+
+/**
+ * Reads all actions from EEPROM. Has to be called before the other methods in this header file can be used
+ */
+void initActions();
+
+/**
+ * Gets the action of the input and gesture
+ * 
+ * @param pin pin of the input
+ * @param gesture gesture recognized
+ * @return action to perform or NULL if no action is set (default behavior applies)
+ */
+Action* getAction(byte pin, Gesture gesture);
+
+/**
+ * Sets the action of the input and gesture, updating the runtime table right away and queueing the EEPROM write
+ * 
+ * @param pin pin of the input
+ * @param gesture gesture to set the action for
+ * @param targets nodeID and operation of each target (2 bytes per target)
+ * @param targetsCount number of targets (0 to remove the action, targets over ACTION_TARGETS are ignored)
+ */
+void updateAction(byte pin, Gesture gesture, byte* targets, byte targetsCount);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SWITCHACTIONS_H */
+
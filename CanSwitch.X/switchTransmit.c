@@ -0,0 +1,264 @@
+/* 
+ * Switch transmit implementation - loads the transmit buffers directly and idles with the watchdog as the timeout while waiting for them,
+ * retries just set the transmit requests again on the buffers aborted
+ * 
+ * File:   switchTransmit.c
+ * Author: pojd
+ *
+ * Created on December 22, 2018, 4:58 PM
+ */
+
+#include "switchTransmit.h"
+
+/** 
+ * All transmit buffers in the order of use within a batch (the highest one is sent first)
+ */
+volatile byte* transmitBuffers[TRANSMIT_BUFFERS_COUNT] = { &TXB2CON, &TXB1CON, &TXB0CON };
+
+// offsets of the registers within the transmit buffer
+#define BUFFER_CON 0
+#define BUFFER_SIDH 1
+#define BUFFER_SIDL 2
+#define BUFFER_DLC 5
+#define BUFFER_DATA 6
+
+// watchdog period in timer 1 counts (us), see config.h
+#define WATCHDOG_PERIOD_US 64000
+
+// TXREQ, TXLARB and TXABT bits of TXBnCON
+#define TXREQ 0b00001000
+#define TXLARB 0b00100000
+#define TXABT 0b01000000
+
+/** index of the next buffer to use in the current batch */
+byte nextTransmitBuffer = 0;
+
+/** number of messages dropped */
+unsigned int transmitDrops = 0;
+
+/** number of bus-off states seen */
+unsigned int busOffs = 0;
+
+/** TRUE if messages got dropped and none was sent since, no retries then */
+boolean transmitFailing = FALSE;
+
+/** TRUE if any message lost arbitration since last checked */
+boolean arbitrationLost = FALSE;
+
+/** ticks (watchdog periods) idled while waiting since last taken (read by the interrupt too) */
+volatile byte idledTicks = 0;
+
+/** time idled since the last tick with the device woken up by other interrupts than the watchdog meanwhile, in us */
+unsigned int idledTime = 0;
+
+/*
+ * Private methods
+ */
+
+boolean isTransmitting() {
+    for (byte i=0; i<TRANSMIT_BUFFERS_COUNT; i++) {
+        if (*transmitBuffers[i] & TXREQ) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+void loadTransmitBuffer(volatile byte* buffer, CanMessage* message) {
+    // keep the arbitration lost of the previous message in the buffer before it gets cleared
+    if (buffer[BUFFER_CON] & TXLARB) {
+        arbitrationLost = TRUE;
+    }
+    
+    // standard ID: 3 bits of message type and 8 bits of nodeID. SIDH holds bits 10..3, SIDL bits 2..0 in its top 3 bits
+    unsigned int id = (message->header->messageType << 8) | message->header->nodeID;
+    buffer[BUFFER_SIDH] = (id >> 3) & MAX_8_BITS;
+    buffer[BUFFER_SIDL] = (id & 0b111) << 5;
+    buffer[BUFFER_DLC] = message->dataLength;
+    
+    byte* data = message->data;
+    for (byte i=0; i<message->dataLength; i++) {
+        buffer[BUFFER_DATA + i] = data[i];
+    }
+    
+    // the same priority for all, request to send at once
+    buffer[BUFFER_CON] = TXREQ;
+}
+
+void clearTransmitInterrupts() {
+    PIR5bits.TXB0IF = 0;
+    PIR5bits.TXB1IF = 0;
+    PIR5bits.TXB2IF = 0;
+}
+
+byte abortTransmit() {
+    // clearing TXREQ aborts the message unless being sent right now, the one being sent is then just not retried
+    byte aborted = 0;
+    for (byte i=0; i<TRANSMIT_BUFFERS_COUNT; i++) {
+        if (*transmitBuffers[i] & TXREQ) {
+            *transmitBuffers[i] &= ~TXREQ;
+            aborted++;
+        }
+    }
+    return aborted;
+}
+
+void dropTransmit() {
+    transmitDrops += abortTransmit();
+    transmitFailing = TRUE;
+    messageStatus.statusCode = ERROR;
+}
+
+void retryTransmit() {
+    // only the buffers really aborted, the message being sent while aborting might have made it. The buffers keep the whole message
+    for (byte i=0; i<TRANSMIT_BUFFERS_COUNT; i++) {
+        if (*transmitBuffers[i] & TXABT) {
+            *transmitBuffers[i] |= TXREQ;
+        }
+    }
+}
+
+/**
+ * Idles till any interrupt wakes the device up, has to be called with interrupts disabled. Any interrupt flag set wakes the device up even then (and if
+ * set already, Sleep does not idle at all), so the interrupts are enabled for a moment afterwards to let the interrupt routine process and clear it
+ * 
+ * @return TRUE if a tick passed meanwhile, i.e. the watchdog woke us up or we idled for a whole watchdog period in total
+ */
+boolean idle() {
+    unsigned int tIdle = getTimerTime();
+    // the watchdog only runs while idling, so it can never expire (and reset the device) while the loop is running
+    CLRWDT();
+    WDTCONbits.SWDTEN = 1;
+    Sleep();
+    WDTCONbits.SWDTEN = 0;
+    // time-out bit cleared means the watchdog woke us up. Time measured otherwise, each idle restarts the watchdog
+    boolean tick = !RCONbits.TO;
+    if (!tick) {
+        idledTime += getTimerTime() - tIdle;
+        tick = (idledTime >= WATCHDOG_PERIOD_US);
+    }
+    if (tick) {
+        idledTime = 0;
+        idledTicks++;
+    }
+    ei();
+    // all interrupts pending are processed right here
+    di();
+    return tick;
+}
+
+void idleTicks(byte ticks) {
+    while (ticks) {
+        if (idle()) {
+            ticks--;
+        }
+    }
+}
+
+/*
+ * API methods
+ */
+
+void initTransmit() {
+    clearTransmitInterrupts();
+    PIE5bits.TXB0IE = 1;
+    PIE5bits.TXB1IE = 1;
+    PIE5bits.TXB2IE = 1;
+    PIE5bits.ERRIE = 1;
+}
+
+void transmit(CanMessage* message) {
+    if (!isTransmitting()) {
+        // previous batch all sent, so start a new one
+        nextTransmitBuffer = 0;
+    } else if (nextTransmitBuffer == TRANSMIT_BUFFERS_COUNT) {
+        waitTransmitted();
+    }
+    loadTransmitBuffer(transmitBuffers[nextTransmitBuffer++], message);
+}
+
+void waitTransmitted() {
+    // interrupts are disabled while waiting, so that no transmit interrupt can come between the check and the idle and leave us idling for nothing.
+    // An interrupt flag set wakes the device up even with interrupts disabled and all interrupts pending are processed right after (see idle)
+    di();
+    OSCCONbits.IDLEN = 1;
+    idledTime = 0;
+    
+    byte timeouts = 0;
+    byte retries = transmitFailing ? TRANSMIT_RETRIES : 0;
+    boolean dropped = FALSE;
+    boolean busOff = FALSE;
+    while (isTransmitting()) {
+        boolean tick = idle();
+        if (COMSTATbits.TXBO && !busOff) {
+            // bus-off, the CAN module rejoins the bus on its own once it sees the bus idle for 128 x 11 bits and sends the messages then
+            busOff = TRUE;
+            busOffs++;
+        }
+        if (tick && ++timeouts >= TRANSMIT_TIMEOUT_TICKS) {
+            // No retries after bus-off, the bus did not even get idle for the whole timeout
+            if (retries == TRANSMIT_RETRIES || busOff) {
+                dropTransmit();
+                dropped = TRUE;
+                // the message being sent while aborting may still be pending, so drop it again after another timeout
+                timeouts = 0;
+            } else {
+                // back off for 1, 2, ... ticks, so that the bus (or the node failing to acknowledge) gets a chance to recover
+                abortTransmit();
+                idleTicks(1 << retries);
+                retries++;
+                retryTransmit();
+                timeouts = 0;
+            }
+        }
+    }
+    if (!dropped) {
+        transmitFailing = FALSE;
+        messageStatus.statusCode = OK;
+        latencyTransmitted();
+    }
+    
+    OSCCONbits.IDLEN = 0;
+    ei();
+    nextTransmitBuffer = 0;
+}
+
+void checkTransmitCompleted() {
+    if (PIR5bits.TXB0IF || PIR5bits.TXB1IF || PIR5bits.TXB2IF) {
+        // means the CAN send just finished OK
+        messageStatus.statusCode = OK;
+        clearTransmitInterrupts();
+        if (!isTransmitting()) {
+            latencyTransmitted();
+        }
+    }
+}
+
+boolean checkArbitrationLost() {
+    for (byte i=0; i<TRANSMIT_BUFFERS_COUNT; i++) {
+        if (*transmitBuffers[i] & TXLARB) {
+            arbitrationLost = TRUE;
+        }
+    }
+    boolean lost = arbitrationLost;
+    arbitrationLost = FALSE;
+    return lost;
+}
+
+unsigned int getTransmitDrops() {
+    return transmitDrops;
+}
+
+byte getIdledTicks() {
+    return idledTicks;
+}
+
+byte takeIdledTicks() {
+    byte ticks = idledTicks;
+    idledTicks = 0;
+    return ticks;
+}
+
+unsigned int getBusOffs() {
+    return busOffs;
+}
@@ -0,0 +1,107 @@
+/* 
+ * Switch transmit sends CAN messages without waiting for each of them to get sent, using all 3 transmit buffers (TXB0-TXB2). Messages are loaded into
+ * the buffers in batches - the first message of a batch into TXB2, then TXB1 and TXB0. ECAN sends the buffers of the same priority starting from the highest one,
+ * so the messages of a batch go out back to back in the order they were sent. The next batch is only started once the previous one is sent.
+ * 
+ * While waiting for the messages to get sent, the device idles (CPU stopped, but the clock keeps running for the CAN module) and is woken up
+ * by the transmit interrupts. The wait checks and idles with interrupts disabled, but does not clear any interrupt flag itself: any enabled flag wakes
+ * the device up (transmit and error interrupts as well as inputs, CAN receive, EEPROM write or timer 0 in DEBUG mode) and the interrupts are enabled
+ * for a moment after each wake up, so that the interrupt routine processes and clears all of them. No flag is left pending for the wait to spin on. Messages that cannot get sent within TRANSMIT_TIMEOUT_TICKS (e.g. nobody else on the bus to acknowledge them) are aborted
+ * and retried up to TRANSMIT_RETRIES times, waiting 1, 2, ... ticks before each retry. Messages still not sent are dropped and counted. Once messages got dropped,
+ * the following ones are not retried at all till a message gets sent again, so a broken bus costs just 1 timeout per wake up. In bus-off (too many transmit errors)
+ * the CAN module rejoins the bus on its own once it sees the bus idle for a while and the messages are sent then, but not retried if not sent within the timeout.
+ * 
+ * File:   switchTransmit.h
+ * Author: pojd
+ *
+ * Created on December 22, 2018, 4:40 PM
+ */
+
+#ifndef SWITCHTRANSMIT_H
+#define	SWITCHTRANSMIT_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <xc.h>
+#include "utils.h"
+#include "can.h"
+#include "wakeLatency.h"
+
+// number of transmit buffers
+#define TRANSMIT_BUFFERS_COUNT 3
+// max time to wait for the messages to get sent in watchdog periods (64ms each, see config.h)
+#define TRANSMIT_TIMEOUT_TICKS 4
+// number of retries of messages not sent in time
+#define TRANSMIT_RETRIES 2
+
+/**
+ * Operations
+ */
+
+/**
+ * Enables the transmit and error interrupts used to wake the device up once messages are sent (or the CAN module goes bus-off). Has to be called after CAN is configured
+ */
+void initTransmit();
+
+/**
+ * Sends the message - loads it into the next transmit buffer of the current batch and returns right away. If all buffers are used already,
+ * waits for all of them to get sent first (see waitTransmitted)
+ * 
+ * @param message message to send (copied, so can be reused by the caller right after this call)
+ */
+void transmit(CanMessage* message);
+
+/**
+ * Idles till all messages sent so far are sent (or aborted after the timeout). Has to be called before the CAN module is put to sleep.
+ * The timebase does not move in non DEBUG mode meanwhile (the watchdog wakes up the wait instead), see takeIdledTicks
+ */
+void waitTransmitted();
+
+/**
+ * Checks whether any message got sent and clears the transmit interrupts. To be called from the interrupt
+ */
+void checkTransmitCompleted();
+
+/**
+ * Checks whether any message sent since the last call lost arbitration, i.e. had to wait for messages of other nodes
+ * 
+ * @return TRUE if arbitration was lost
+ */
+boolean checkArbitrationLost();
+
+/**
+ * Gets the number of messages dropped since start since they could not be sent in time even after all retries (or the CAN module was in bus-off)
+ * 
+ * @return number of messages dropped
+ */
+unsigned int getTransmitDrops();
+
+/**
+ * Gets the ticks (watchdog periods) idled while waiting for messages to get sent since the last call, so that the timebase can catch up with them
+ * 
+ * @return number of ticks idled
+ */
+byte takeIdledTicks();
+
+/**
+ * Gets the ticks idled while waiting for messages to get sent not taken yet (see takeIdledTicks), can be called from the interrupt
+ * 
+ * @return number of ticks idled
+ */
+byte getIdledTicks();
+
+/**
+ * Gets the number of times the CAN module was found in bus-off while sending since start
+ * 
+ * @return number of bus-off states seen
+ */
+unsigned int getBusOffs();
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SWITCHTRANSMIT_H */
+
@@ -0,0 +1,71 @@
+/* 
+ * Wake latency implementation - timer 1 is reset on each wake up and never interrupts, the overflow flag only marks the time being out of range
+ * 
+ * File:   wakeLatency.c
+ * Author: pojd
+ *
+ * Created on December 27, 2018, 5:34 PM
+ */
+
+#include "wakeLatency.h"
+
+WakeLatency wakeLatency = { 0, 0, LATENCY_OVERFLOW, 0 };
+
+/** TRUE if a message was requested after the last wake up and is not yet sent */
+volatile boolean latencyRequested = FALSE;
+
+/*
+ * API methods
+ */
+
+void initWakeLatency() {
+    // instruction clock, prescaler 1:4, 16 bit reads, timer on
+    T1CON = 0b00100011;
+}
+
+void latencyWake() {
+    TMR1H = 0;
+    TMR1L = 0;
+    PIR1bits.TMR1IF = 0;
+    latencyRequested = FALSE;
+}
+
+unsigned int getTimeSinceWake() {
+    if (PIR1bits.TMR1IF) {
+        return LATENCY_OVERFLOW;
+    }
+    unsigned int time = getTimerTime();
+    return PIR1bits.TMR1IF ? LATENCY_OVERFLOW : time;
+}
+
+unsigned int getTimerTime() {
+    // reading the low byte latches the high byte (16 bit reads)
+    byte low = TMR1L;
+    return (TMR1H << 8) | low;
+}
+
+void latencyTransmitRequested() {
+    if (!latencyRequested) {
+        wakeLatency.lastRequest = getTimeSinceWake();
+        latencyRequested = TRUE;
+    }
+}
+
+void latencyTransmitted() {
+    if (!latencyRequested) {
+        return;
+    }
+    unsigned int time = getTimeSinceWake();
+    wakeLatency.lastComplete = time;
+    if (time < wakeLatency.minComplete) {
+        wakeLatency.minComplete = time;
+    }
+    if (time > wakeLatency.maxComplete) {
+        wakeLatency.maxComplete = time;
+    }
+    latencyRequested = FALSE;
+}
+
+WakeLatency* getWakeLatency() {
+    return &wakeLatency;
+}
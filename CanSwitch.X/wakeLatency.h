@@ -0,0 +1,88 @@
+/* 
+ * Wake latency measures how long it takes from the device waking up to a press being sent over CAN. Timer 1 counts instruction cycles from the wake up 
+ * (prescaler 1:4, i.e. 1 count = 1us at 16MHz) and is read when the first NORMAL message is requested to be sent and when all messages are sent.
+ * 
+ * The time of the oscillator start up before the first instruction runs and of the input interrupt itself is not included.
+ * Times longer than the timer range (65ms) are reported as LATENCY_OVERFLOW.
+ * 
+ * File:   wakeLatency.h
+ * Author: pojd
+ *
+ * Created on December 27, 2018, 5:20 PM
+ */
+
+#ifndef WAKELATENCY_H
+#define	WAKELATENCY_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <xc.h>
+#include "utils.h"
+
+// latency longer than the timer range
+#define LATENCY_OVERFLOW 0xFFFF
+
+/**
+ * Latencies in us measured so far
+ */
+typedef struct {
+    unsigned int lastRequest; // from wake up to the first message requested to be sent (last wake up with a message sent)
+    unsigned int lastComplete; // from wake up to all messages sent (last wake up with a message sent)
+    unsigned int minComplete; // min of lastComplete since start
+    unsigned int maxComplete; // max of lastComplete since start
+} WakeLatency;
+
+/**
+ * Operations
+ */
+
+/**
+ * Starts the timer used to measure. Has to be called before the other methods in this header file can be used
+ */
+void initWakeLatency();
+
+/**
+ * Marks the device being woken up, i.e. starts measuring from now
+ */
+void latencyWake();
+
+/**
+ * Gets the time since the wake up (see latencyWake)
+ * 
+ * @return time in us
+ */
+unsigned int getTimeSinceWake();
+
+/**
+ * Gets the time of the timer as is - it wraps around instead of saturating at LATENCY_OVERFLOW, so the difference of 2 calls is always the time
+ * between them (as long as shorter than 65ms). To be used to wait for short intervals
+ * 
+ * @return time in us
+ */
+unsigned int getTimerTime();
+
+/**
+ * Marks a message being requested to be sent. Only the first one after the wake up is measured
+ */
+void latencyTransmitRequested();
+
+/**
+ * Marks all messages being sent. Only measured if a message was requested after the wake up
+ */
+void latencyTransmitted();
+
+/**
+ * Gets the latencies measured so far
+ * 
+ * @return reference to the latencies
+ */
+WakeLatency* getWakeLatency();
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* WAKELATENCY_H */
+
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+#
+# Validates CAN bit timing of the nodes (PIC18F K80 ECAN) for the bit rate, clock and bus length given.
+#
+# Lists all valid settings of BRGCON registers (baud rate prescaler and segments in time quanta) for the bit rate
+# and checks that the propagation segment covers the round trip delay over the whole bus, i.e. that the bit rate
+# can really be used on a bus this long. Use it before switching the network to a new bit rate (see canNetwork.h).
+# The timings are listed with the most time quanta first, then the latest sample point first. The firmware programs the very first one
+# for the installed 300m bus (bitTimings in CanSetup.X/canNetwork.c), so a bit rate is only supported there if it is valid here.
+#
+# Usage: ./canBitTiming.py <bit rate in kbps> [bus length in m (default 300)] [clock in MHz (default 16)]
+# E.g. ./canBitTiming.py 125 300 16
+
+import sys
+
+# signal propagation over a twisted pair cable (ns per meter) and loop delay of a transceiver and the controller (ns)
+CABLE_DELAY_NS_PER_M = 5.0
+NODE_DELAY_NS = 250.0
+
+# ECAN limits (in time quanta)
+MIN_TQ, MAX_TQ = 8, 25
+MAX_BRP = 64
+MAX_PRSEG, MAX_SEG1, MAX_SEG2, MAX_SJW = 8, 8, 8, 4
+
+# sample point window recommended for CAN
+MIN_SAMPLE_POINT, MAX_SAMPLE_POINT = 0.75, 0.875
+
+
+def timings(bitRate, busLength, clock):
+    fosc = clock * 1e6
+    bit = 1.0 / (bitRate * 1e3)
+    roundTrip = 2 * (busLength * CABLE_DELAY_NS_PER_M + NODE_DELAY_NS) * 1e-9
+
+    for brp in range(1, MAX_BRP + 1):
+        tq = 2.0 * brp / fosc
+        nominal = bit / tq
+        tqCount = int(round(nominal))
+        if abs(nominal - tqCount) > 1e-6 or tqCount < MIN_TQ or tqCount > MAX_TQ:
+            continue
+
+        prseg = int(-(-roundTrip // tq))  # ceiling
+        if prseg < 1 or prseg > MAX_PRSEG:
+            continue
+        for seg2 in range(2, MAX_SEG2 + 1):
+            seg1 = tqCount - 1 - prseg - seg2
+            if seg1 < 1 or seg1 > MAX_SEG1 or seg2 > seg1 + prseg:
+                continue
+            samplePoint = (1 + prseg + seg1) / tqCount
+            if MIN_SAMPLE_POINT <= samplePoint <= MAX_SAMPLE_POINT:
+                sjw = min(MAX_SJW, seg2)
+                yield brp, tqCount, prseg, seg1, seg2, sjw, samplePoint
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: canBitTiming.py <bit rate in kbps> [bus length in m (default 300)] [clock in MHz (default 16)]")
+        sys.exit(1)
+
+    bitRate = int(sys.argv[1])
+    busLength = float(sys.argv[2]) if len(sys.argv) > 2 else 300
+    clock = float(sys.argv[3]) if len(sys.argv) > 3 else 16
+
+    found = False
+    for brp, tqCount, prseg, seg1, seg2, sjw, samplePoint in timings(bitRate, busLength, clock):
+        found = True
+        brgcon1 = ((sjw - 1) << 6) | (brp - 1)
+        brgcon2 = 0b10000000 | ((seg1 - 1) << 3) | (prseg - 1)
+        brgcon3 = seg2 - 1
+        print("BRP=%d TQ=%d PRSEG=%d SEG1=%d SEG2=%d SJW=%d sample point=%d%% BRGCON1=0x%02X BRGCON2=0x%02X BRGCON3=0x%02X"
+              % (brp, tqCount, prseg, seg1, seg2, sjw, samplePoint * 100, brgcon1, brgcon2, brgcon3))
+
+    if not found:
+        print("No valid timing for %d kbps on a %dm bus with %gMHz clock" % (bitRate, busLength, clock))
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()